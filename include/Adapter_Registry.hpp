@@ -0,0 +1,180 @@
+/**
+ * @file Adapter_Registry.hpp
+ * @brief Registry of airline and hotel adapters
+ * @details Provides:
+ *          - FlightProvider / HotelProvider: How to build and book with one brand
+ *          - AdapterRegistry: Brands registered by ID, enabled from a configuration file
+ *
+ *          Each adapter source file registers its brands at start-up; nothing else
+ *          needs to know the concrete adapter classes.
+ *
+ * @author Abdallah Salem
+ */
+#ifndef HEADERS_ADAPTER_REGISTRY_HPP_
+#define HEADERS_ADAPTER_REGISTRY_HPP_
+
+#include <mutex>
+#include <vector>
+#include <string>
+#include <functional>
+#include "Flight_Reservation.hpp"
+#include "Hotel_Reservation.hpp"
+#include "Connection_Search.hpp"
+#include "Provider_Registry.hpp"
+#include "Search_Cache.hpp"
+
+/**
+ * @class FlightProvider
+ * @brief Constructors and inventory of one airline.
+ */
+class FlightProvider {
+public:
+	/// Builds an adapter used for searching.
+	std::function<FlightReservation_ptr()> adapter;
+	/// Builds the reservation of a chosen flight.
+	std::function<Reservation_ptr(PassengerQuery, FlightInfo_ptr&&)> book;
+	/// Appends the airline's local inventory as legs (optional).
+	std::function<void(std::vector<FlightLeg>&)> inventory;
+	/// Reports the counters of the airline's searches (optional).
+	std::function<SearchStats()> stats;
+};
+
+/**
+ * @class HotelProvider
+ * @brief Constructors of one hotel chain.
+ */
+class HotelProvider {
+public:
+	/// Builds an adapter used for searching.
+	std::function<HotelReservation_ptr()> adapter;
+	/// Builds the reservation of a chosen room.
+	std::function<Reservation_ptr(CustomerQuery, RoomInfo_ptr&&)> book;
+	/// Reports the counters of the chain's searches (optional).
+	std::function<SearchStats()> stats;
+};
+
+/**
+ * @class AdapterRegistry
+ * @brief Process-wide table of airline and hotel adapters, indexed by ProviderId.
+ * @details Brands register their constructors during static initialization. Which of
+ *          them a deployment uses is read once, on first use, from the providers file
+ *          (see configure()); adapters are only built for enabled brands and only when
+ *          a search first needs them. Booking dispatch is a direct index by ProviderId.
+ */
+class AdapterRegistry {
+private:
+	/// Airlines by ProviderId; empty slots belong to hotels or unknown IDs.
+	std::vector<FlightProvider> flights;
+	/// Hotel chains by ProviderId; empty slots belong to airlines or unknown IDs.
+	std::vector<HotelProvider> hotels;
+	/// Airlines enabled in this deployment, in configuration order.
+	std::vector<ProviderId> enabled_flights;
+	/// Hotel chains enabled in this deployment, in configuration order.
+	std::vector<ProviderId> enabled_hotels;
+	/// Reads the providers file once.
+	std::once_flag configured;
+
+	/**
+	 * @brief Private constructor, use instance().
+	 */
+	AdapterRegistry() = default;
+
+	/**
+	 * @brief Reads the providers file on first call.
+	 */
+	void configureOnce();
+
+public:
+	/**
+	 * @brief Deleted copy constructor, the registry is a singleton.
+	 */
+	AdapterRegistry(const AdapterRegistry &other) = delete;
+
+	/**
+	 * @brief Deleted copy assignment operator.
+	 */
+	AdapterRegistry& operator=(const AdapterRegistry &other) = delete;
+
+	/**
+	 * @brief Gets the process-wide registry.
+	 * @return Reference to the registry.
+	 */
+	static AdapterRegistry& instance();
+
+	/**
+	 * @brief Registers an airline.
+	 * @param id The airline's interned ID.
+	 * @param provider Its constructors.
+	 * @return True, so registration can initialize a static.
+	 */
+	bool addFlightProvider(ProviderId id, FlightProvider provider);
+
+	/**
+	 * @brief Registers a hotel chain.
+	 * @param id The chain's interned ID.
+	 * @param provider Its constructors.
+	 * @return True, so registration can initialize a static.
+	 */
+	bool addHotelProvider(ProviderId id, HotelProvider provider);
+
+	/**
+	 * @brief Enables the brands listed in a providers file.
+	 * @details Lines are "flight <name>" or "hotel <name>"; blank lines and lines starting
+	 *          with '#' are ignored. Without the file every registered brand is enabled.
+	 * @param path Path of the providers file.
+	 */
+	void configure(const std::string &path);
+
+	/**
+	 * @brief Builds one search adapter per enabled airline.
+	 * @return The adapters.
+	 */
+	std::vector<FlightReservation_ptr> makeFlightAdapters();
+
+	/**
+	 * @brief Builds one search adapter per enabled hotel chain.
+	 * @return The adapters.
+	 */
+	std::vector<HotelReservation_ptr> makeHotelAdapters();
+
+	/**
+	 * @brief Appends the local inventory of every enabled airline as legs.
+	 * @param legs Vector the legs are appended to.
+	 */
+	void appendInventoryLegs(std::vector<FlightLeg> &legs);
+
+	/**
+	 * @brief Gets the search counters of every enabled brand that reports them.
+	 * @return One snapshot per brand, airlines first.
+	 */
+	std::vector<SearchStats> searchStats();
+
+	/**
+	 * @brief Checks whether an ID belongs to a registered airline.
+	 * @param id The ID.
+	 * @return True for an airline.
+	 */
+	bool isFlightProvider(ProviderId id) const;
+
+	/**
+	 * @brief Builds the reservation of a chosen flight.
+	 * @param id The airline's ID.
+	 * @param passenger_info The passenger's request.
+	 * @param flight The chosen flight.
+	 * @return The reservation, or nullptr for an unknown airline.
+	 */
+	Reservation_ptr bookFlight(ProviderId id, PassengerQuery passenger_info,
+			FlightInfo_ptr &&flight) const;
+
+	/**
+	 * @brief Builds the reservation of a chosen room.
+	 * @param id The hotel chain's ID.
+	 * @param customer_info The customer's request.
+	 * @param room The chosen room.
+	 * @return The reservation, or nullptr for an unknown chain.
+	 */
+	Reservation_ptr bookHotel(ProviderId id, CustomerQuery customer_info,
+			RoomInfo_ptr &&room) const;
+};
+
+#endif /* HEADERS_ADAPTER_REGISTRY_HPP_ */
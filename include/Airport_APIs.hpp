@@ -4,7 +4,8 @@
  * @details Provides classes for:
  *          - Airline customer information (AirCanadaCustomerInfo, TurkishCustomerInfo)
  *          - Flight details (AirCanadaFlight, TurkishFlight)
- *          - API operations (AirCanadaOnlineAPI, TurkishAirlineOnlineAPI)
+ *          - API operations (AirCanadaOnlineAPI, TurkishAirlineOnlineAPI), blocking or as
+ *            coroutines run on an EventLoop
  * @author Abdallah Salem
  *
  */
@@ -13,6 +14,9 @@
 #define HEADERS_AIRPORTS_APIS_HPP_
 #include<iostream>
 #include<vector>
+#include "Date.hpp"
+#include "Money.hpp"
+#include "Async_Call.hpp"
 
 /**
  * @class AirCanadaCustomerInfo
@@ -25,8 +29,8 @@ class AirCanadaCustomerInfo {
 public:
 	std::string from;  ///< Origin airport or city.
 	std::string to;   ///< Destination airport or city.
-	std::string date_time_from;    ///< Departure date and time.
-	std::string date_time_to;     ///< Arrival date and time.
+	DateTime date_time_from;    ///< Departure date and time.
+	DateTime date_time_to;     ///< Arrival date and time.
 	int adults { };             ///< Number of adult passengers.
 	int children { };           ///< Number of child passengers.
 	int infants { };            ///< Number of infant passengers.
@@ -47,7 +51,7 @@ public:
 	 * @param infants Number of infant passengers.
 	 */
 	AirCanadaCustomerInfo(std::string from, std::string to,
-			std::string date_time_from, std::string date_time_to, int adults,
+			DateTime date_time_from, DateTime date_time_to, int adults,
 			int children, int infants);
 };
 
@@ -60,9 +64,9 @@ public:
 
 class AirCanadaFlight {
 public:
-	double price { };           ///< Price of the flight.
-	std::string date_time_from; ///< Departure date and time.
-	std::string date_time_to;   ///< Arrival date and time.
+	Money price;              ///< Price of the flight.
+	DateTime date_time_from; ///< Departure date and time.
+	DateTime date_time_to;   ///< Arrival date and time.
 
 	/*
 	 * @brief default constructor.
@@ -75,7 +79,7 @@ public:
 	 * @param from Departure date and time.
 	 * @param to Arrival date and time.
 	 */
-	AirCanadaFlight(double price, std::string from, std::string to);
+	AirCanadaFlight(Money price, DateTime from, DateTime to);
 };
 
 /**
@@ -95,9 +99,11 @@ public:
 
 	/**
 	 * @brief Retrieves a list of available flights.
+	 * @param info The search (route and dates).
 	 * @return Vector of available AirCanadaFlight objects.
 	 */
-	static std::vector<AirCanadaFlight> getFlights();
+	static std::vector<AirCanadaFlight> getFlights(
+			const AirCanadaCustomerInfo &info);
 
 	/**
 	 * @brief Attempts to reserve a flight.
@@ -117,6 +123,35 @@ public:
 	 */
 	static bool cancelReserveFlight(const AirCanadaFlight &flight,
 			const AirCanadaCustomerInfo &info);
+
+	/**
+	 * @brief Retrieves available flights without holding a thread while waiting.
+	 * @param loop The loop the call waits on.
+	 * @param info The search (route and dates).
+	 * @return Vector of available AirCanadaFlight objects.
+	 */
+	static Task<std::vector<AirCanadaFlight>> getFlightsAsync(EventLoop &loop,
+			AirCanadaCustomerInfo info);
+
+	/**
+	 * @brief Reserves a flight without holding a thread while waiting.
+	 * @param loop The loop the call waits on.
+	 * @param flight Flight to reserve.
+	 * @param info Customer information for the reservation.
+	 * @return True if reservation succeeds, false otherwise.
+	 */
+	static Task<bool> reserveFlightAsync(EventLoop &loop, AirCanadaFlight flight,
+			AirCanadaCustomerInfo info);
+
+	/**
+	 * @brief Cancels a flight reservation without holding a thread while waiting.
+	 * @param loop The loop the call waits on.
+	 * @param flight Flight to cancel.
+	 * @param info Customer information associated with the reservation.
+	 * @return True if cancellation succeeds, false otherwise.
+	 */
+	static Task<bool> cancelReserveFlightAsync(EventLoop &loop,
+			AirCanadaFlight flight, AirCanadaCustomerInfo info);
 };
 
 /**
@@ -130,8 +165,8 @@ class TurkishCustomerInfo {
 public:
 	std::string from;          ///< Origin airport or city.
 	std::string to;            ///< Destination airport or city.
-	std::string datetime_from; ///< Departure date and time.
-	std::string datetime_to;   ///< Arrival date and time.
+	DateTime datetime_from; ///< Departure date and time.
+	DateTime datetime_to;   ///< Arrival date and time.
 	int adults { };            ///< Number of adult passengers.
 	int children { };          ///< Number of child passengers.
 	int infants { };           ///< Number of infant passengers.
@@ -152,7 +187,7 @@ public:
 	 * @param infants Number of infant passengers.
 	 */
 	TurkishCustomerInfo(std::string from, std::string to,
-			std::string datetime_from, std::string datetime_to, int adults,
+			DateTime datetime_from, DateTime datetime_to, int adults,
 			int children, int infants);
 };
 
@@ -163,9 +198,9 @@ public:
 
 class TurkishFlight {
 public:
-	double cost { };           ///< Cost of the flight.
-	std::string datetime_from; ///< Departure date and time.
-	std::string datetime_to;   ///< Arrival date and time.
+	Money cost;               ///< Cost of the flight.
+	DateTime datetime_from; ///< Departure date and time.
+	DateTime datetime_to;   ///< Arrival date and time.
 	/*
 	 * @brief default constructor
 	 */
@@ -177,7 +212,7 @@ public:
 	 * @param from Departure date and time.
 	 * @param to Arrival date and time.
 	 */
-	TurkishFlight(double cost, std::string from, std::string to);
+	TurkishFlight(Money cost, DateTime from, DateTime to);
 };
 
 /**
@@ -200,9 +235,11 @@ public:
 
 	/**
 	 * @brief Retrieves a list of available flights.
+	 * @param info The search (route and dates).
 	 * @return Vector of available TurkishFlight objects.
 	 */
-	static std::vector<TurkishFlight> getAvailableFlights();
+	static std::vector<TurkishFlight> getAvailableFlights(
+			const TurkishCustomerInfo &info);
 
 	/**
 	 * @brief Attempts to reserve a flight.
@@ -221,6 +258,35 @@ public:
 	 */
 	static bool cancelReservedFlight(const TurkishCustomerInfo &info,
 			const TurkishFlight &flight);
+
+	/**
+	 * @brief Retrieves available flights without holding a thread while waiting.
+	 * @param loop The loop the call waits on.
+	 * @param info The search (route and dates).
+	 * @return Vector of available TurkishFlight objects.
+	 */
+	static Task<std::vector<TurkishFlight>> getAvailableFlightsAsync(
+			EventLoop &loop, TurkishCustomerInfo info);
+
+	/**
+	 * @brief Reserves a flight without holding a thread while waiting.
+	 * @param loop The loop the call waits on.
+	 * @param info Customer information for the reservation.
+	 * @param flight Flight to reserve.
+	 * @return True if reservation succeeds, false otherwise.
+	 */
+	static Task<bool> reserveFlightAsync(EventLoop &loop,
+			TurkishCustomerInfo info, TurkishFlight flight);
+
+	/**
+	 * @brief Cancels a flight reservation without holding a thread while waiting.
+	 * @param loop The loop the call waits on.
+	 * @param info Customer information associated with the reservation.
+	 * @param flight Flight to cancel.
+	 * @return True if cancellation succeeds, false otherwise.
+	 */
+	static Task<bool> cancelReservedFlightAsync(EventLoop &loop,
+			TurkishCustomerInfo info, TurkishFlight flight);
 };
 
 #endif /* HEADERS_AIRPORTS_APIS_HPP_ */
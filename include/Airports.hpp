@@ -4,7 +4,7 @@
  * @details Contains:
  *          - CanadaFlightReservation: Adapter for Air Canada API
  *          - TurkishFlightReservation: Adapter for Turkish Airlines API
- *          - Defines smart pointer types for airline-specific objects
+ *          - Both read the shared passenger request, converting it only at the API call
  * @author Abdallah Salem
  *
  */
@@ -14,17 +14,8 @@
 
 #include "Airport_APIs.hpp"
 #include "Flight_Reservation.hpp"
-
-/**
- * @brief Typedefs for unique pointers to airline-specific customer info and flight objects.
- *
- * These aliases simplify the use of smart pointers for managing airline data objects,
- * ensuring proper resource management and ownership semantics.
- */
-typedef std::unique_ptr<AirCanadaCustomerInfo> AirCanadaCustomerInfo_ptr;
-typedef std::unique_ptr<AirCanadaFlight> AirCanadaFlight_ptr;
-typedef std::unique_ptr<TurkishCustomerInfo> TurkishCustomerInfo_ptr;
-typedef std::unique_ptr<TurkishFlight> TurkishFlight_ptr;
+#include "Search_Cache.hpp"
+#include "Connection_Search.hpp"
 
 /**
  * @class CanadaFlightReservation
@@ -34,10 +25,10 @@ typedef std::unique_ptr<TurkishFlight> TurkishFlight_ptr;
  * for Air Canada, including setting customer information, selecting flights, retrieving
  * available flights, calculating costs, and handling reservation operations.
  */
-class CanadaFlightReservation: public FlightReservation {
+class CanadaFlightReservation final : public FlightReservation {
 private:
-	AirCanadaCustomerInfo_ptr canada_customer_info; ///< Unique pointer to Air Canada's customer info.
-	AirCanadaFlight_ptr canada_chosen_flight; ///< Unique pointer to the chosen Air Canada flight.
+	PassengerQuery passenger_query; ///< Shared request, put in Air Canada's format at each API call.
+	AirCanadaFlight canada_chosen_flight; ///< The chosen Air Canada flight.
 
 public:
 	/**
@@ -50,13 +41,12 @@ public:
 	/**
 	 * @brief Constructs a reservation with provided customer and flight information.
 	 *
-	 * This constructor initializes the object by moving the ownership of the provided
-	 * customer and flight information pointers.
+	 * This constructor shares the provided request and takes the selected flight.
 	 *
-	 * @param customer_info Unique pointer to passenger information.
+	 * @param customer_info Shared pointer to passenger information.
 	 * @param chosen_flight Unique pointer to the selected flight details.
 	 */
-	CanadaFlightReservation(PassengerInfo_ptr &&customer_info,
+	CanadaFlightReservation(PassengerQuery customer_info,
 			FlightInfo_ptr &&chosen_flight);
 
 	/**
@@ -100,12 +90,12 @@ public:
 	/**
 	 * @brief Sets the customer information for the reservation.
 	 *
-	 * This method updates the customer details by moving the ownership of the provided
-	 * passenger information pointer and interacts with the Air Canada API to set the data.
+	 * This method keeps a reference to the shared request; it is converted to Air
+	 * Canada's format only when the API is called.
 	 *
-	 * @param customer_info Unique pointer to passenger information.
+	 * @param customer_info Shared pointer to passenger information.
 	 */
-	void setCustomerInfo(PassengerInfo_ptr &&customer_info) override;
+	void setCustomerInfo(PassengerQuery customer_info) override;
 
 	/**
 	 * @brief Sets the chosen flight for the reservation.
@@ -123,16 +113,59 @@ public:
 	 * This method fetches the list of available flights based on the set customer information
 	 * and populates the provided vector with flight details.
 	 *
+	 * Answers are cached per normalized request, so repeated searches for the same
+	 * route, dates and passenger mix are served without calling the API.
+	 *
 	 * @param flights Vector to store the available flight information.
 	 */
 	void getAvailableFlights(std::vector<FoundFlightInfo> &&flights) override;
 
+	/**
+	 * @brief Appends this provider's answer to a columnar result buffer.
+	 * @details Shares the search cache and hedger with getAvailableFlights().
+	 * @param columns Buffer the offers are appended to.
+	 */
+	void appendAvailableFlights(FlightColumns &columns) override;
+
+	/**
+	 * @brief Retrieves available flights, awaiting the airline on the loop.
+	 * @details Shares the search cache and hedger with getAvailableFlights().
+	 * @param loop The loop the call waits on.
+	 * @return The available flights.
+	 */
+	Task<std::vector<FoundFlightInfo>> getAvailableFlightsAsync(EventLoop &loop)
+			override;
+
+	/**
+	 * @brief Gets the interned ID of this airline, stamped on every search result.
+	 *
+	 * @return The airline's ProviderId.
+	 */
+	static ProviderId providerId();
+
+	/**
+	 * @brief Reports the counters of the shared search pipeline of this airline.
+	 *
+	 * @return Cache hits, misses, evictions and size, and the coalesced searches.
+	 */
+	static SearchStats searchStats();
+
+	/**
+	 * @brief Appends every flight of this airline's local inventory as a leg.
+	 *
+	 * Feeds the connection search; nothing is appended when the airline has no
+	 * inventory file.
+	 *
+	 * @param legs Vector the legs are appended to.
+	 */
+	static void appendInventoryLegs(std::vector<FlightLeg> &legs);
+
 	/**
 	 * @brief Calculates and returns the cost of the chosen flight.
 	 *
 	 * @return The total cost of the flight reservation.
 	 */
-	double getCost() const override;
+	Money getCost() const override;
 
 	/**
 	 * @brief Creates a clone of this reservation object.
@@ -144,16 +177,18 @@ public:
 	/**
 	 * @brief Makes the flight reservation using the Air Canada API.
 	 *
+	 * @param loop The loop the call waits on.
 	 * @return True if the reservation is successfully made, false otherwise.
 	 */
-	bool makeReservation() override;
+	Task<bool> makeReservationAsync(EventLoop &loop) override;
 
 	/**
 	 * @brief Cancels the flight reservation using the Air Canada API.
 	 *
+	 * @param loop The loop the call waits on.
 	 * @return True if the reservation is successfully canceled, false otherwise.
 	 */
-	bool cancelReservation() override;
+	Task<bool> cancelReservationAsync(EventLoop &loop) override;
 
 	/**
 	 * @brief Outputs flight reservation details to the provided ostream.
@@ -174,10 +209,10 @@ public:
  * for Turkish Airlines, including setting customer information, selecting flights,
  * retrieving available flights, calculating costs, and handling reservation operations.
  */
-class TurkishFlightReservation: public FlightReservation {
+class TurkishFlightReservation final : public FlightReservation {
 private:
-	TurkishCustomerInfo_ptr turkish_customer_info; ///< Unique pointer to Turkish Airlines' customer info.
-	TurkishFlight_ptr turkish_chosen_flight; ///< Unique pointer to the chosen Turkish Airlines flight.
+	PassengerQuery passenger_query; ///< Shared request, put in Turkish Airlines' format at each API call.
+	TurkishFlight turkish_chosen_flight; ///< The chosen Turkish Airlines flight.
 
 public:
 	/**
@@ -190,13 +225,12 @@ public:
 	/**
 	 * @brief Constructs a reservation with provided customer and flight information.
 	 *
-	 * This constructor initializes the object by moving the ownership of the provided
-	 * customer and flight information pointers.
+	 * This constructor shares the provided request and takes the selected flight.
 	 *
-	 * @param customer_info Unique pointer to passenger information.
+	 * @param customer_info Shared pointer to passenger information.
 	 * @param chosen_flight Unique pointer to the selected flight details.
 	 */
-	TurkishFlightReservation(PassengerInfo_ptr &&customer_info,
+	TurkishFlightReservation(PassengerQuery customer_info,
 			FlightInfo_ptr &&chosen_flight);
 
 	/**
@@ -240,12 +274,12 @@ public:
 	/**
 	 * @brief Sets the customer information for the reservation.
 	 *
-	 * This method updates the customer details by moving the ownership of the provided
-	 * passenger information pointer and interacts with the Turkish Airlines API to set the data.
+	 * This method keeps a reference to the shared request; it is converted to Turkish
+	 * Airlines' format only when the API is called.
 	 *
-	 * @param customer_info Unique pointer to passenger information.
+	 * @param customer_info Shared pointer to passenger information.
 	 */
-	void setCustomerInfo(PassengerInfo_ptr &&customer_info) override;
+	void setCustomerInfo(PassengerQuery customer_info) override;
 
 	/**
 	 * @brief Sets the chosen flight for the reservation.
@@ -263,16 +297,59 @@ public:
 	 * This method fetches the list of available flights based on the set customer information
 	 * and populates the provided vector with flight details.
 	 *
+	 * Answers are cached per normalized request, so repeated searches for the same
+	 * route, dates and passenger mix are served without calling the API.
+	 *
 	 * @param flights Vector to store the available flight information.
 	 */
 	void getAvailableFlights(std::vector<FoundFlightInfo> &&flights) override;
 
+	/**
+	 * @brief Appends this provider's answer to a columnar result buffer.
+	 * @details Shares the search cache and hedger with getAvailableFlights().
+	 * @param columns Buffer the offers are appended to.
+	 */
+	void appendAvailableFlights(FlightColumns &columns) override;
+
+	/**
+	 * @brief Retrieves available flights, awaiting the airline on the loop.
+	 * @details Shares the search cache and hedger with getAvailableFlights().
+	 * @param loop The loop the call waits on.
+	 * @return The available flights.
+	 */
+	Task<std::vector<FoundFlightInfo>> getAvailableFlightsAsync(EventLoop &loop)
+			override;
+
+	/**
+	 * @brief Gets the interned ID of this airline, stamped on every search result.
+	 *
+	 * @return The airline's ProviderId.
+	 */
+	static ProviderId providerId();
+
+	/**
+	 * @brief Reports the counters of the shared search pipeline of this airline.
+	 *
+	 * @return Cache hits, misses, evictions and size, and the coalesced searches.
+	 */
+	static SearchStats searchStats();
+
+	/**
+	 * @brief Appends every flight of this airline's local inventory as a leg.
+	 *
+	 * Feeds the connection search; nothing is appended when the airline has no
+	 * inventory file.
+	 *
+	 * @param legs Vector the legs are appended to.
+	 */
+	static void appendInventoryLegs(std::vector<FlightLeg> &legs);
+
 	/**
 	 * @brief Calculates and returns the cost of the chosen flight.
 	 *
 	 * @return The total cost of the flight reservation.
 	 */
-	double getCost() const override;
+	Money getCost() const override;
 
 	/**
 	 * @brief Creates a clone of this reservation object.
@@ -284,16 +361,18 @@ public:
 	/**
 	 * @brief Makes the flight reservation using the Turkish Airlines API.
 	 *
+	 * @param loop The loop the call waits on.
 	 * @return True if the reservation is successfully made, false otherwise.
 	 */
-	bool makeReservation() override;
+	Task<bool> makeReservationAsync(EventLoop &loop) override;
 
 	/**
 	 * @brief Cancels the flight reservation using the Turkish Airlines API.
 	 *
+	 * @param loop The loop the call waits on.
 	 * @return True if the reservation is successfully canceled, false otherwise.
 	 */
-	bool cancelReservation() override;
+	Task<bool> cancelReservationAsync(EventLoop &loop) override;
 
 	/**
 	 * @brief Outputs flight reservation details to the provided ostream.
@@ -0,0 +1,517 @@
+/**
+ * @file Async_Call.hpp
+ * @brief Coroutine support for asynchronous provider calls
+ * @details Provides:
+ *          - Task: Lazily started coroutine producing one value, awaitable by other tasks
+ *          - EventLoop: A few threads resuming coroutines that are ready or whose timer is due
+ *          - whenAll: Runs tasks concurrently on a loop and gathers their results
+ *          - syncWait: Blocks the calling thread until a task finishes
+ *
+ *          A call suspended on a provider holds no thread, so thousands of calls can be in
+ *          flight on a handful of loop threads.
+ *
+ * @author Abdallah Salem
+ */
+#ifndef HEADERS_ASYNC_CALL_HPP_
+#define HEADERS_ASYNC_CALL_HPP_
+
+#include <mutex>
+#include <queue>
+#include <deque>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <utility>
+#include <optional>
+#include <exception>
+#include <stdexcept>
+#include <coroutine>
+#include <condition_variable>
+
+/**
+ * @class Task
+ * @brief Coroutine producing one value of type Result.
+ * @details The body does not start until the task is awaited, and resumes its awaiter when it
+ *          finishes. Parameters taken by reference must outlive the task; take them by value
+ *          when the caller may not wait for it.
+ * @tparam Result The value produced (not void).
+ */
+template<typename Result>
+class Task {
+public:
+	/**
+	 * @class promise_type
+	 * @brief Coroutine state: the value or error, and who to resume at the end.
+	 */
+	class promise_type {
+	public:
+		/// The value returned by the body.
+		std::optional<Result> value;
+		/// The exception that escaped the body.
+		std::exception_ptr error;
+		/// Coroutine waiting for this one.
+		std::coroutine_handle<> continuation;
+
+		/**
+		 * @class FinalAwaiter
+		 * @brief Hands the thread to the awaiting coroutine when the body ends.
+		 */
+		class FinalAwaiter {
+		public:
+			bool await_ready() const noexcept {
+				return false;
+			}
+
+			std::coroutine_handle<> await_suspend(
+					std::coroutine_handle<promise_type> finished) noexcept {
+				std::coroutine_handle<> next = finished.promise().continuation;
+				return next ? next : std::noop_coroutine();
+			}
+
+			void await_resume() const noexcept {
+			}
+		};
+
+		Task get_return_object() {
+			return Task(std::coroutine_handle<promise_type>::from_promise(*this));
+		}
+
+		std::suspend_always initial_suspend() const noexcept {
+			return {};
+		}
+
+		FinalAwaiter final_suspend() const noexcept {
+			return {};
+		}
+
+		void return_value(Result result) {
+			value.emplace(std::move(result));
+		}
+
+		void unhandled_exception() {
+			error = std::current_exception();
+		}
+	};
+
+private:
+	/// The coroutine, owned by the task.
+	std::coroutine_handle<promise_type> handle;
+
+	/**
+	 * @brief Takes ownership of a started coroutine.
+	 */
+	explicit Task(std::coroutine_handle<promise_type> handle) :
+			handle(handle) {
+	}
+
+	/**
+	 * @class Awaiter
+	 * @brief Starts the task and suspends its awaiter until it finishes.
+	 * @details An empty task is not started; taking its result throws.
+	 * @tparam Take True to hand out the result, false only to wait for it.
+	 */
+	template<bool Take>
+	class Awaiter {
+	public:
+		/// The awaited task.
+		Task &task;
+
+		bool await_ready() const noexcept {
+			return !task.handle || task.handle.done();
+		}
+
+		std::coroutine_handle<> await_suspend(
+				std::coroutine_handle<> awaiting) noexcept {
+			task.handle.promise().continuation = awaiting;
+			return task.handle;
+		}
+
+		auto await_resume() {
+			if constexpr (Take)
+				return task.result();
+		}
+	};
+
+public:
+	/**
+	 * @brief Move constructor; the moved-from task is empty.
+	 */
+	Task(Task &&other) noexcept :
+			handle(std::exchange(other.handle, nullptr)) {
+	}
+
+	/**
+	 * @brief Move assignment operator; the moved-from task is empty.
+	 */
+	Task& operator=(Task &&other) noexcept {
+		if (this != &other) {
+			if (handle)
+				handle.destroy();
+			handle = std::exchange(other.handle, nullptr);
+		}
+		return *this;
+	}
+
+	/**
+	 * @brief Deleted copy constructor; a coroutine has one owner.
+	 */
+	Task(const Task &other) = delete;
+
+	/**
+	 * @brief Deleted copy assignment operator.
+	 */
+	Task& operator=(const Task &other) = delete;
+
+	/**
+	 * @brief Destroys the coroutine; it must not be running.
+	 */
+	~Task() {
+		if (handle)
+			handle.destroy();
+	}
+
+	/**
+	 * @brief Runs the task and gets its result.
+	 */
+	Awaiter<true> operator co_await() noexcept {
+		return Awaiter<true> { *this };
+	}
+
+	/**
+	 * @brief Runs the task without taking its result.
+	 * @return Awaitable resumed when the body has finished, even by an exception.
+	 */
+	Awaiter<false> finished() noexcept {
+		return Awaiter<false> { *this };
+	}
+
+	/**
+	 * @brief Gets the result of a finished task.
+	 * @return The value returned by the body.
+	 * @throws std::logic_error If the task is empty (moved from).
+	 * @throws The exception that escaped the body.
+	 */
+	Result result() {
+		if (!handle)
+			throw std::logic_error("awaiting an empty task");
+		if (handle.promise().error)
+			std::rethrow_exception(handle.promise().error);
+		return std::move(*handle.promise().value);
+	}
+};
+
+/**
+ * @class EventLoop
+ * @brief A few threads resuming coroutines as they become ready.
+ * @details Coroutines are posted to run now or at a deadline; any idle thread resumes the
+ *          next one. A coroutine waiting on a timer holds no thread.
+ */
+class EventLoop {
+private:
+	/**
+	 * @class Timer
+	 * @brief A coroutine to resume at a deadline.
+	 */
+	class Timer {
+	public:
+		/// When to resume.
+		std::chrono::steady_clock::time_point due;
+		/// The coroutine.
+		std::coroutine_handle<> waiting;
+
+		bool operator>(const Timer &other) const {
+			return due > other.due;
+		}
+	};
+
+	/// Threads owned by the loop.
+	std::vector<std::thread> workers;
+	/// Coroutines ready to run.
+	std::deque<std::coroutine_handle<>> ready;
+	/// Coroutines sleeping, earliest deadline first.
+	std::priority_queue<Timer, std::vector<Timer>, std::greater<Timer>> timers;
+	/// Guards the queues and the stopping flag.
+	std::mutex lock;
+	/// Signals workers that a coroutine is ready, a timer changed or the loop is stopping.
+	std::condition_variable wake;
+	/// Set once the loop is being destroyed.
+	bool stopping { };
+
+	/**
+	 * @brief Worker loop: resumes coroutines until the loop stops.
+	 */
+	void run();
+
+public:
+	/**
+	 * @class Schedule
+	 * @brief Awaitable moving the awaiting coroutine onto a loop thread.
+	 */
+	class Schedule {
+	public:
+		/// The loop to move to.
+		EventLoop &loop;
+
+		bool await_ready() const noexcept {
+			return false;
+		}
+
+		void await_suspend(std::coroutine_handle<> awaiting) {
+			loop.post(awaiting);
+		}
+
+		void await_resume() const noexcept {
+		}
+	};
+
+	/**
+	 * @class Sleep
+	 * @brief Awaitable resuming the awaiting coroutine on a loop thread after a deadline.
+	 */
+	class Sleep {
+	public:
+		/// The loop to resume on.
+		EventLoop &loop;
+		/// When to resume.
+		std::chrono::steady_clock::time_point due;
+
+		bool await_ready() const noexcept {
+			return due <= std::chrono::steady_clock::now();
+		}
+
+		void await_suspend(std::coroutine_handle<> awaiting) {
+			loop.postAt(due, awaiting);
+		}
+
+		void await_resume() const noexcept {
+		}
+	};
+
+	/**
+	 * @brief Starts the given number of loop threads.
+	 * @param threads Number of threads (at least one is started).
+	 */
+	explicit EventLoop(std::size_t threads);
+
+	/**
+	 * @brief Deleted copy constructor; threads cannot be shared.
+	 */
+	EventLoop(const EventLoop &other) = delete;
+
+	/**
+	 * @brief Deleted copy assignment operator.
+	 */
+	EventLoop& operator=(const EventLoop &other) = delete;
+
+	/**
+	 * @brief Runs what is ready and joins the threads; sleeping coroutines are dropped.
+	 */
+	~EventLoop();
+
+	/**
+	 * @brief Gets the loop the provider adapters run on.
+	 * @return Reference to a process-wide loop with a few threads.
+	 */
+	static EventLoop& instance();
+
+	/**
+	 * @brief Queues a coroutine to be resumed on a loop thread.
+	 * @param waiting The coroutine.
+	 */
+	void post(std::coroutine_handle<> waiting);
+
+	/**
+	 * @brief Queues a coroutine to be resumed once a deadline passes.
+	 * @param due The deadline.
+	 * @param waiting The coroutine.
+	 */
+	void postAt(std::chrono::steady_clock::time_point due,
+			std::coroutine_handle<> waiting);
+
+	/**
+	 * @brief Moves the awaiting coroutine onto a loop thread.
+	 * @return Awaitable.
+	 */
+	Schedule schedule() {
+		return Schedule { *this };
+	}
+
+	/**
+	 * @brief Suspends the awaiting coroutine without holding a thread.
+	 * @param delay How long to wait.
+	 * @return Awaitable.
+	 */
+	Sleep sleepFor(std::chrono::microseconds delay) {
+		return Sleep { *this, std::chrono::steady_clock::now() + delay };
+	}
+};
+
+/**
+ * @class Detached
+ * @brief Coroutine that starts at once and frees itself when it ends; used to launch tasks.
+ */
+class Detached {
+public:
+	/**
+	 * @class promise_type
+	 * @brief Coroutine state of a detached coroutine.
+	 */
+	class promise_type {
+	public:
+		Detached get_return_object() const noexcept {
+			return {};
+		}
+
+		std::suspend_never initial_suspend() const noexcept {
+			return {};
+		}
+
+		std::suspend_never final_suspend() const noexcept {
+			return {};
+		}
+
+		void return_void() const noexcept {
+		}
+
+		void unhandled_exception() const noexcept {
+			std::terminate();
+		}
+	};
+};
+
+/**
+ * @class TaskLatch
+ * @brief Resumes one coroutine after a number of tasks have arrived.
+ */
+class TaskLatch {
+private:
+	/// Arrivals still expected, plus one for the waiting coroutine.
+	std::atomic<std::size_t> remaining;
+	/// The coroutine to resume.
+	std::coroutine_handle<> waiting;
+
+public:
+	/**
+	 * @brief Creates a latch.
+	 * @param count Number of arrivals to wait for.
+	 */
+	explicit TaskLatch(std::size_t count) :
+			remaining(count + 1) {
+	}
+
+	/**
+	 * @brief Records one arrival, resuming the waiting coroutine if it was the last.
+	 */
+	void arrive() {
+		if (remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+			waiting.resume();
+	}
+
+	bool await_ready() const noexcept {
+		return remaining.load(std::memory_order_acquire) == 1;
+	}
+
+	bool await_suspend(std::coroutine_handle<> awaiting) noexcept {
+		waiting = awaiting;
+		//stay suspended unless every task arrived in the meantime.
+		return remaining.fetch_sub(1, std::memory_order_acq_rel) != 1;
+	}
+
+	void await_resume() const noexcept {
+	}
+};
+
+/**
+ * @brief Runs one task of a whenAll on the loop and reports its end to the latch.
+ */
+template<typename Result>
+Detached runOnLoop(EventLoop &loop, Task<Result> &task, TaskLatch &latch) {
+	co_await loop.schedule();
+	co_await task.finished();
+	latch.arrive();
+}
+
+/**
+ * @brief Runs tasks concurrently on a loop.
+ * @param loop The loop to run them on.
+ * @param tasks The tasks.
+ * @return Their results in order.
+ * @throws The exception of the first failed task, once all have finished.
+ */
+template<typename Result>
+Task<std::vector<Result>> whenAll(EventLoop &loop,
+		std::vector<Task<Result>> tasks) {
+	TaskLatch latch(tasks.size());
+	for (Task<Result> &task : tasks)
+		runOnLoop(loop, task, latch);
+	co_await latch;
+	std::vector<Result> results;
+	results.reserve(tasks.size());
+	for (Task<Result> &task : tasks)
+		results.push_back(task.result());
+	co_return results;
+}
+
+/**
+ * @class Completion
+ * @brief One-shot signal from a coroutine to a blocked thread.
+ */
+class Completion {
+private:
+	/// Guards done.
+	std::mutex lock;
+	/// Signalled when done is set.
+	std::condition_variable signalled;
+	/// Set once the coroutine has finished.
+	bool done { };
+
+public:
+	/**
+	 * @brief Wakes the waiting thread.
+	 */
+	void signal() {
+		std::lock_guard<std::mutex> guard(lock);
+		done = true;
+		signalled.notify_all();
+	}
+
+	/**
+	 * @brief Blocks until signal() is called.
+	 */
+	void wait() {
+		std::unique_lock<std::mutex> guard(lock);
+		signalled.wait(guard, [this] {
+			return done;
+		});
+	}
+};
+
+/**
+ * @brief Runs a task on the loop and signals when it has finished.
+ */
+template<typename Result>
+Detached signalOnLoop(EventLoop &loop, Task<Result> &task,
+		Completion &completion) {
+	co_await loop.schedule();
+	co_await task.finished();
+	completion.signal();
+}
+
+/**
+ * @brief Blocks the calling thread until a task has run on a loop.
+ * @details Must not be called from a thread of that loop.
+ * @param loop The loop to run the task on.
+ * @param task The task.
+ * @return The task's result.
+ * @throws The task's exception.
+ */
+template<typename Result>
+Result syncWait(EventLoop &loop, Task<Result> task) {
+	Completion completion;
+	signalOnLoop(loop, task, completion);
+	completion.wait();
+	return task.result();
+}
+
+#endif /* HEADERS_ASYNC_CALL_HPP_ */
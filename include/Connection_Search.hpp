@@ -0,0 +1,145 @@
+/**
+ * @file Connection_Search.hpp
+ * @brief Multi-leg flight connection search
+ * @details Provides:
+ *          - FlightLeg: One scheduled flight of any airline
+ *          - ConnectionGoal: What a connection search minimizes
+ *          - Connection: A chain of legs from origin to destination
+ *          - ConnectionSearch: Shortest-path search over a time-expanded flight graph
+ *
+ * @author Abdallah Salem
+ */
+#ifndef HEADERS_CONNECTION_SEARCH_HPP_
+#define HEADERS_CONNECTION_SEARCH_HPP_
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <cstdint>
+#include <unordered_map>
+#include "Date.hpp"
+#include "Money.hpp"
+#include "Provider_Registry.hpp"
+
+/**
+ * @class FlightLeg
+ * @brief A single scheduled flight between two airports.
+ */
+class FlightLeg {
+public:
+	std::string from;     ///< Origin airport or city.
+	std::string to;       ///< Destination airport or city.
+	ProviderId airline { }; ///< Airline operating the flight.
+	Money price;          ///< Ticket price.
+	DateTime departure;   ///< Departure date and time.
+	DateTime arrival;     ///< Arrival date and time.
+};
+
+/**
+ * @enum ConnectionGoal
+ * @brief What a connection search minimizes.
+ */
+enum class ConnectionGoal {
+	CHEAPEST, ///< Lowest total ticket price.
+	FASTEST   ///< Shortest time from first departure to last arrival.
+};
+
+/**
+ * @class Connection
+ * @brief A chain of legs from origin to destination.
+ */
+class Connection {
+public:
+	std::vector<std::uint32_t> legs; ///< Legs in travel order, as ConnectionSearch::leg() indexes.
+	Money price;                     ///< Sum of the legs' prices.
+	std::int32_t minutes { };        ///< First departure to last arrival, in minutes.
+};
+
+/**
+ * @class ConnectionSearch
+ * @brief Finds connections with a bounded number of stops over the combined inventory.
+ * @details Legs are the nodes of a time-expanded graph: a leg links to every leg leaving
+ *          its arrival airport after the minimum connection time and within the maximum
+ *          layover. Legs are grouped by origin airport and sorted by departure, so the
+ *          links of a leg are one binary search plus a contiguous scan.
+ *
+ *          The search is label-setting (Dijkstra) over (leg, stops) with cost either the
+ *          price so far or the time since the first departure; both only grow along a
+ *          path. A label is pruned when the same leg was reached with no more stops at no
+ *          higher cost, which bounds the work to a few labels per leg.
+ */
+class ConnectionSearch {
+private:
+	/// Legs grouped by origin airport, each group sorted by departure.
+	std::vector<FlightLeg> legs;
+	/// Origin airport of each leg.
+	std::vector<std::uint32_t> origin;
+	/// Destination airport of each leg.
+	std::vector<std::uint32_t> destination;
+	/// Departure of each leg, minutes since 01-01-1970.
+	std::vector<std::int32_t> departure;
+	/// Arrival of each leg, minutes since 01-01-1970.
+	std::vector<std::int32_t> arrival;
+	/// Legs leaving airport a are [first_departure[a], first_departure[a + 1]).
+	std::vector<std::uint32_t> first_departure;
+	/// Airport IDs by normalized name.
+	std::unordered_map<std::string, std::uint32_t> airports;
+	/// Minimum time between arriving and departing again at the same airport.
+	std::int32_t min_connection;
+	/// Longest wait accepted between two legs.
+	std::int32_t max_layover;
+
+	/**
+	 * @brief Looks up an airport ID.
+	 * @param name Airport or city name.
+	 * @param id Receives the ID.
+	 * @return False if no leg touches the airport.
+	 */
+	bool airport(const std::string &name, std::uint32_t &id) const;
+
+public:
+	/**
+	 * @brief Builds the flight graph.
+	 * @param legs Every leg of every airline.
+	 * @param min_connection_minutes Minimum connection time at an airport.
+	 * @param max_layover_minutes Longest accepted wait between two legs.
+	 */
+	explicit ConnectionSearch(std::vector<FlightLeg> &&legs,
+			int min_connection_minutes = 60, int max_layover_minutes = 24 * 60);
+
+	/**
+	 * @brief Finds the best connections between two airports.
+	 * @param from Origin airport or city.
+	 * @param to Destination airport or city.
+	 * @param earliest Earliest accepted first departure.
+	 * @param latest Latest accepted first departure.
+	 * @param max_stops Most intermediate stops (0 for direct flights only).
+	 * @param goal What to minimize.
+	 * @param limit Most connections returned.
+	 * @return Connections, best first.
+	 */
+	std::vector<Connection> search(const std::string &from,
+			const std::string &to, DateTime earliest, DateTime latest,
+			int max_stops, ConnectionGoal goal, std::size_t limit) const;
+
+	/**
+	 * @brief Accesses a leg by index.
+	 * @param index Index from Connection::legs.
+	 * @return The leg.
+	 */
+	const FlightLeg& leg(std::uint32_t index) const;
+
+	/**
+	 * @brief Gets the number of legs in the graph.
+	 * @return Number of legs.
+	 */
+	std::size_t size() const;
+};
+
+/**
+ * @typedef ConnectionSearch_ptr
+ * @brief Smart pointer to a ConnectionSearch object.
+ */
+typedef std::unique_ptr<ConnectionSearch> ConnectionSearch_ptr;
+
+#endif /* HEADERS_CONNECTION_SEARCH_HPP_ */
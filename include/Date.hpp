@@ -0,0 +1,231 @@
+/**
+ * @file Date.hpp
+ * @brief Compact calendar date and date-time value types
+ * @details Contains:
+ *          - Date: Day count since 01-01-1970, parsed from "dd-mm-yyyy"
+ *          - DateTime: Minute count since 01-01-1970 00:00, parsed from "dd-mm-yyyy[ hh:mm]"
+ *
+ *          Dates are parsed once where they enter the system (user input, provider
+ *          answers) and then travel as a single integer, so copying, comparing and
+ *          sorting them never touches the heap.
+ *
+ * @author Abdallah Salem
+ */
+#ifndef HEADERS_DATE_HPP_
+#define HEADERS_DATE_HPP_
+
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <cstdint>
+#include <limits>
+
+/**
+ * @class Date
+ * @brief Calendar day stored as the number of days since 01-01-1970.
+ */
+class Date {
+private:
+	/// Marker of a date that was never set or failed to parse.
+	static constexpr std::int32_t INVALID = std::numeric_limits<std::int32_t>::min();
+
+	/// Days since 01-01-1970 (negative before it).
+	std::int32_t days { INVALID };
+
+public:
+	/// Latest year a date may fall in, so its midnight still fits a DateTime.
+	static constexpr int MAX_YEAR = 6000;
+
+	/**
+	 * @brief Default constructor, creates an invalid date.
+	 */
+	constexpr Date() = default;
+
+	/**
+	 * @brief Creates a date from its day count.
+	 * @param days Days since 01-01-1970.
+	 */
+	constexpr explicit Date(std::int32_t days) :
+			days(days) {
+	}
+
+	/**
+	 * @brief Creates a date from its calendar fields.
+	 * @param day Day of month (1-31).
+	 * @param month Month (1-12).
+	 * @param year Year.
+	 * @return The date, or an invalid date if the fields do not name a real day or the
+	 *         year is past MAX_YEAR.
+	 */
+	static Date fromCivil(int day, int month, int year);
+
+	/**
+	 * @brief Parses a "dd-mm-yyyy" string.
+	 * @param text The text to parse, in any string.
+	 * @return The date, or an invalid date if the text is malformed.
+	 */
+	static Date parse(std::string_view text);
+
+	/**
+	 * @brief Checks whether the date holds a real day.
+	 * @return True if the date is valid.
+	 */
+	constexpr bool isValid() const {
+		return days != INVALID;
+	}
+
+	/**
+	 * @brief Gets the day count.
+	 * @return Days since 01-01-1970.
+	 */
+	constexpr std::int32_t dayNumber() const {
+		return days;
+	}
+
+	/**
+	 * @brief Formats the date as "dd-mm-yyyy".
+	 * @return The formatted date, or an empty string if invalid.
+	 */
+	std::string toString() const;
+
+	/// Dates compare by their day count.
+	constexpr bool operator==(const Date &other) const {
+		return days == other.days;
+	}
+	constexpr bool operator!=(const Date &other) const {
+		return days != other.days;
+	}
+	constexpr bool operator<(const Date &other) const {
+		return days < other.days;
+	}
+	constexpr bool operator<=(const Date &other) const {
+		return days <= other.days;
+	}
+	constexpr bool operator>(const Date &other) const {
+		return days > other.days;
+	}
+	constexpr bool operator>=(const Date &other) const {
+		return days >= other.days;
+	}
+
+	/**
+	 * @brief Writes the date as "dd-mm-yyyy".
+	 * @param out Output stream.
+	 * @param date The date to write.
+	 * @return Reference to the output stream.
+	 */
+	friend std::ostream& operator<<(std::ostream &out, const Date &date);
+};
+
+/**
+ * @class DateTime
+ * @brief Point in time stored as the number of minutes since 01-01-1970 00:00.
+ */
+class DateTime {
+private:
+	/// Marker of a date-time that was never set or failed to parse.
+	static constexpr std::int32_t INVALID = std::numeric_limits<std::int32_t>::min();
+
+	/// Minutes since 01-01-1970 00:00.
+	std::int32_t minutes { INVALID };
+
+public:
+	/// Minutes in one day.
+	static constexpr std::int32_t MINUTES_PER_DAY = 24 * 60;
+	/// First day whose minutes fit, with room for the INVALID marker.
+	static constexpr std::int32_t FIRST_DAY =
+			std::numeric_limits<std::int32_t>::min() / MINUTES_PER_DAY + 1;
+	/// Last day whose every minute fits.
+	static constexpr std::int32_t LAST_DAY =
+			std::numeric_limits<std::int32_t>::max() / MINUTES_PER_DAY - 1;
+
+	/**
+	 * @brief Default constructor, creates an invalid date-time.
+	 */
+	constexpr DateTime() = default;
+
+	/**
+	 * @brief Creates a date-time from its minute count.
+	 * @param minutes Minutes since 01-01-1970 00:00.
+	 */
+	constexpr explicit DateTime(std::int32_t minutes) :
+			minutes(minutes) {
+	}
+
+	/**
+	 * @brief Creates the date-time at midnight of the given date.
+	 * @param date The calendar day; days outside [FIRST_DAY, LAST_DAY] give an invalid
+	 *        date-time.
+	 */
+	constexpr DateTime(Date date) :
+			minutes(
+					date.isValid() && date.dayNumber() >= FIRST_DAY
+							&& date.dayNumber() <= LAST_DAY ?
+							date.dayNumber() * MINUTES_PER_DAY : INVALID) {
+	}
+
+	/**
+	 * @brief Parses "dd-mm-yyyy" (midnight) or "dd-mm-yyyy hh:mm".
+	 * @param text The text to parse, in any string; 'T' is accepted instead of the space.
+	 * @return The date-time, or an invalid date-time if the text is malformed.
+	 */
+	static DateTime parse(std::string_view text);
+
+	/**
+	 * @brief Checks whether the date-time holds a real moment.
+	 * @return True if the date-time is valid.
+	 */
+	constexpr bool isValid() const {
+		return minutes != INVALID;
+	}
+
+	/**
+	 * @brief Gets the minute count.
+	 * @return Minutes since 01-01-1970 00:00.
+	 */
+	constexpr std::int32_t minuteNumber() const {
+		return minutes;
+	}
+
+	/**
+	 * @brief Gets the calendar day of this moment.
+	 * @return The date, or an invalid date if this date-time is invalid.
+	 */
+	Date date() const;
+
+	/**
+	 * @brief Formats as "dd-mm-yyyy", followed by " hh:mm" unless it is midnight.
+	 * @return The formatted date-time, or an empty string if invalid.
+	 */
+	std::string toString() const;
+
+	/// Date-times compare by their minute count.
+	constexpr bool operator==(const DateTime &other) const {
+		return minutes == other.minutes;
+	}
+	constexpr bool operator!=(const DateTime &other) const {
+		return minutes != other.minutes;
+	}
+	constexpr bool operator<(const DateTime &other) const {
+		return minutes < other.minutes;
+	}
+	constexpr bool operator<=(const DateTime &other) const {
+		return minutes <= other.minutes;
+	}
+	constexpr bool operator>(const DateTime &other) const {
+		return minutes > other.minutes;
+	}
+	constexpr bool operator>=(const DateTime &other) const {
+		return minutes >= other.minutes;
+	}
+
+	/**
+	 * @brief Writes the date-time in the format of toString().
+	 * @param out Output stream.
+	 * @param date_time The date-time to write.
+	 * @return Reference to the output stream.
+	 */
+	friend std::ostream& operator<<(std::ostream &out, const DateTime &date_time);
+};
+
+#endif /* HEADERS_DATE_HPP_ */
@@ -14,6 +14,9 @@
 #include "User_Manager.hpp"
 #include "Itinerary_Builder.hpp"
 #include "Payment_Handler.hpp"
+#include "Itinerary_Commit.hpp"
+#include "Provider_Metrics.hpp"
+#include "Adapter_Registry.hpp"
 
 /**
  * @class Manager
@@ -52,10 +55,19 @@ private:
 	void addItinerary(std::string input);
 
 	/**
-	 * @brief Saves the current itinerary after payment processing.
+	 * @brief Books the current itinerary, charges for it and saves it.
+	 * @details Nothing is charged unless every booking is made; a failed payment
+	 *          cancels the bookings again.
 	 */
 	void save();
 
+	/**
+	 * @brief Prints the provider call metrics, limiters and search counters so far.
+	 * @details The same call metrics and limiters are written at exit when
+	 *          EXPEDIA_CALL_METRICS names a file.
+	 */
+	void providerStatistics();
+
 	/**
 	 * @brief Retrieves or creates the singleton instance of Manager.
 	 * @return Shared pointer to the Manager instance.
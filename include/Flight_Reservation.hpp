@@ -3,8 +3,9 @@
  * @brief Abstract base class for flight reservations
  * @details Declares interface for:
  *          - Setting passenger information
- *          - Retrieving available flights
+ *          - Retrieving available flights, as records or into a columnar buffer
  *          - Making/canceling reservations
+ *          - Coroutine flight search for use on an EventLoop
  *
  * @author Abdallah Salem
  */
@@ -14,6 +15,14 @@
 
 #include "Reservation.hpp"            ///< Includes the base Reservation class.
 #include "Flight_Reservation_Info.hpp" ///< Includes definitions for PassengerInfo and FlightInfo.
+#include "Result_Columns.hpp"
+#include <functional>
+
+/**
+ * @typedef FlightBatch
+ * @brief Receiver of one batch of flights found by an adapter.
+ */
+typedef std::function<void(std::vector<FoundFlightInfo>&&)> FlightBatch;
 
 /**
  * @class FlightReservation
@@ -29,11 +38,12 @@ public:
 	 * @brief Sets the customer information for the flight reservation.
 	 *
 	 * This method is responsible for storing the customer's travel preferences
-	 * and passenger details, taking ownership of the provided PassengerInfo object.
+	 * and passenger details. The request is shared, not copied; it is converted to the
+	 * airline's format only when the airline is called.
 	 *
-	 * @param customer_info Unique pointer to the customer's travel information.
+	 * @param customer_info Shared pointer to the customer's travel information.
 	 */
-	virtual void setCustomerInfo(PassengerInfo_ptr &&customer_info) = 0;
+	virtual void setCustomerInfo(PassengerQuery customer_info) = 0;
 
 	/**
 	 * @brief Retrieves available flights based on the customer's information.
@@ -47,6 +57,55 @@ public:
 	virtual void getAvailableFlights(
 			std::vector<FoundFlightInfo> &&flights) = 0;
 
+	/**
+	 * @brief Appends available flights to a columnar result buffer.
+	 *
+	 * The default goes through getAvailableFlights(); adapters override it to write
+	 * their answer straight into the columns.
+	 *
+	 * @param columns Buffer the flights are appended to.
+	 */
+	virtual void appendAvailableFlights(FlightColumns &columns) {
+		std::vector<FoundFlightInfo> flights;
+		getAvailableFlights(std::move(flights));
+		columns.reserve(columns.size() + flights.size());
+		for (const FoundFlightInfo &flight : flights)
+			columns.append(flight);
+	}
+
+	/**
+	 * @brief Delivers the available flights within a filter's bounds in batches as they
+	 *        are found.
+	 *
+	 * The default filters the columns of appendAvailableFlights() and hands over the
+	 * flights kept as one batch; adapters able to answer piecemeal override it.
+	 *
+	 * @param filter Bounds the flights are kept within.
+	 * @param batch Receiver called once per batch.
+	 */
+	virtual void streamAvailableFlights(const FlightFilter &filter,
+			const FlightBatch &batch) {
+		FlightColumns columns;
+		appendAvailableFlights(columns);
+		batch(columns.rows(filter.select(columns)));
+	}
+
+	/**
+	 * @brief Retrieves available flights without holding a thread while the airline answers.
+	 *
+	 * The default runs getAvailableFlights() on the loop thread; adapters override it to
+	 * await their airline. The reservation must outlive the task.
+	 *
+	 * @param loop The loop the call waits on.
+	 * @return The available flights.
+	 */
+	virtual Task<std::vector<FoundFlightInfo>> getAvailableFlightsAsync(
+			[[maybe_unused]] EventLoop &loop) {
+		std::vector<FoundFlightInfo> flights;
+		getAvailableFlights(std::move(flights));
+		co_return flights;
+	}
+
 	/**
 	 * @brief Sets the chosen flight for the reservation.
 	 *
@@ -61,19 +120,23 @@ public:
 	 * @brief Attempts to make the flight reservation.
 	 *
 	 * This method interacts with the external airline system to book the selected flight.
+	 * The blocking makeReservation() waits on it.
 	 *
+	 * @param loop The loop the call waits on.
 	 * @return True if the reservation is successfully made, false otherwise.
 	 */
-	virtual bool makeReservation() = 0;
+	virtual Task<bool> makeReservationAsync(EventLoop &loop) = 0;
 
 	/**
 	 * @brief Cancels an existing flight reservation.
 	 *
 	 * This method interacts with the external airline system to cancel the booking.
+	 * The blocking cancelReservation() waits on it.
 	 *
+	 * @param loop The loop the call waits on.
 	 * @return True if the reservation is successfully canceled, false otherwise.
 	 */
-	virtual bool cancelReservation() = 0;
+	virtual Task<bool> cancelReservationAsync(EventLoop &loop) = 0;
 
 	/**
 	 * @brief Virtual destructor.
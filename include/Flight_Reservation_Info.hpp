@@ -14,6 +14,9 @@
 
 #include <iostream>
 #include <memory>
+#include "Date.hpp"
+#include "Money.hpp"
+#include "Provider_Registry.hpp"
 
 /**
  * @class FoundFlightInfo
@@ -25,10 +28,10 @@
  */
 class FoundFlightInfo {
 public:
-	std::string airline;        ///< Name of the airline offering the flight.
-	double price { };           ///< Cost of the flight ticket.
-	std::string from_date;      ///< Departure date and time.
-	std::string to_date;        ///< Arrival date and time.
+	ProviderId airline { };     ///< Interned ID of the airline offering the flight.
+	Money price;                ///< Cost of the flight ticket.
+	DateTime from_date;         ///< Departure date and time.
+	DateTime to_date;           ///< Arrival date and time.
 
 	/**
 	 * @brief Default constructor.
@@ -42,13 +45,13 @@ public:
 	 *
 	 * Creates a FoundFlightInfo object with the provided flight details.
 	 *
-	 * @param airline Name of the airline.
+	 * @param airline ID of the airline.
 	 * @param price Cost of the flight.
 	 * @param from_date Departure date and time.
 	 * @param to_date Arrival date and time.
 	 */
-	FoundFlightInfo(std::string airline, double price, std::string from_date,
-			std::string to_date);
+	FoundFlightInfo(ProviderId airline, Money price, DateTime from_date,
+			DateTime to_date);
 
 	/**
 	 * @brief Copy constructor.
@@ -98,8 +101,8 @@ public:
  */
 class PassengerInfo {
 public:
-	std::string from_date;      ///< Desired departure date.
-	std::string to_date;        ///< Desired return date (if applicable).
+	Date from_date;             ///< Desired departure date.
+	Date to_date;               ///< Desired return date (if applicable).
 	std::string from;           ///< Origin airport or city.
 	std::string to;             ///< Destination airport or city.
 	int children { };           ///< Number of child passengers.
@@ -126,7 +129,7 @@ public:
 	 * @param adults Number of adult passengers.
 	 * @param infants Number of infant passengers.
 	 */
-	PassengerInfo(std::string from_date, std::string to_date, std::string from,
+	PassengerInfo(Date from_date, Date to_date, std::string from,
 			std::string to, int children, int adults, int infants);
 
 	/**
@@ -180,4 +183,12 @@ typedef std::unique_ptr<FoundFlightInfo> FlightInfo_ptr;
  */
 typedef std::unique_ptr<PassengerInfo> PassengerInfo_ptr;
 
+/**
+ * @typedef PassengerQuery
+ * @brief Shared, read-only passenger request.
+ * @details One request is read by every airline adapter of a search and by the
+ *          reservation booked from it, instead of each of them copying it.
+ */
+typedef std::shared_ptr<const PassengerInfo> PassengerQuery;
+
 #endif /* HEADERS_FLIGHT_RESERVATION_INFO_HPP_ */
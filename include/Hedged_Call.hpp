@@ -0,0 +1,410 @@
+/**
+ * @file Hedged_Call.hpp
+ * @brief Hedged provider calls
+ * @details Provides:
+ *          - LatencyTracker: Recent latencies of one provider and their percentiles
+ *          - HedgeRace: Shared outcome of a call and its hedge
+ *          - Hedger: Re-issues a slow call once it passes the provider's observed p95,
+ *            blocking or on an EventLoop
+ *
+ *          Hedging is off unless EXPEDIA_HEDGE_BUDGET gives the largest fraction of calls
+ *          that may be hedged (e.g. 0.05).
+ *
+ * @author Abdallah Salem
+ */
+#ifndef HEADERS_HEDGED_CALL_HPP_
+#define HEADERS_HEDGED_CALL_HPP_
+
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+#include <optional>
+#include <exception>
+#include <utility>
+#include <coroutine>
+#include <functional>
+#include <condition_variable>
+#include "Async_Call.hpp"
+
+/**
+ * @class LatencyTracker
+ * @brief Sliding window of a provider's most recent call latencies.
+ */
+class LatencyTracker {
+private:
+	/// Latencies in microseconds; a ring once full.
+	std::vector<std::int64_t> samples;
+	/// Slot the next sample overwrites once the window is full.
+	std::size_t next { };
+	/// Window size.
+	std::size_t window;
+	/// Guards the samples.
+	mutable std::mutex lock;
+
+public:
+	/**
+	 * @brief Creates an empty tracker.
+	 * @param window Number of recent calls kept.
+	 */
+	explicit LatencyTracker(std::size_t window = 512);
+
+	/**
+	 * @brief Records one call.
+	 * @param latency How long it took.
+	 */
+	void record(std::chrono::microseconds latency);
+
+	/**
+	 * @brief Gets a percentile of the recorded latencies.
+	 * @param fraction The percentile as a fraction (0.95 for p95).
+	 * @return The latency, zero if nothing was recorded.
+	 */
+	std::chrono::microseconds percentile(double fraction) const;
+
+	/**
+	 * @brief Gets the number of latencies in the window.
+	 * @return Sample count.
+	 */
+	std::size_t count() const;
+};
+
+/**
+ * @class HedgeRace
+ * @brief Outcome shared by a call and its hedge; the first success wins.
+ * @details A blocked thread waits with take(); a coroutine awaits settledOn() and is posted
+ *          back to its loop once the race is settled.
+ * @tparam Result The call's result type.
+ */
+template<typename Result>
+class HedgeRace {
+private:
+	/// Guards every member.
+	std::mutex lock;
+	/// Signalled when a request succeeds or fails.
+	std::condition_variable settled;
+	/// Result of the first request to succeed.
+	std::optional<Result> result;
+	/// Error of the latest failed request.
+	std::exception_ptr error;
+	/// Number of requests launched.
+	int launched { };
+	/// Number of requests that failed.
+	int failed { };
+	/// Coroutine awaiting the outcome, if any.
+	std::coroutine_handle<> waiting;
+	/// Loop the waiting coroutine is resumed on.
+	EventLoop *waiting_loop { };
+
+	/**
+	 * @brief Checks whether a request succeeded or every launched one failed; the lock
+	 *        must be held.
+	 */
+	bool isSettled() const {
+		return result || failed == launched;
+	}
+
+	/**
+	 * @brief Resumes the waiting coroutine once the race is settled.
+	 * @param guard The held lock, released before resuming.
+	 */
+	void wakeIfSettled(std::unique_lock<std::mutex> &guard) {
+		std::coroutine_handle<> waiter;
+		EventLoop *loop = waiting_loop;
+		if (isSettled())
+			waiter = std::exchange(waiting, nullptr);
+		guard.unlock();
+		settled.notify_all();
+		if (waiter)
+			loop->post(waiter);
+	}
+
+public:
+	/**
+	 * @class Settled
+	 * @brief Awaitable resumed on a loop once the race is settled.
+	 */
+	class Settled {
+	public:
+		/// The awaited race.
+		HedgeRace &race;
+		/// Loop to resume on.
+		EventLoop &loop;
+
+		bool await_ready() const noexcept {
+			return false;
+		}
+
+		bool await_suspend(std::coroutine_handle<> awaiting) {
+			std::lock_guard<std::mutex> guard(race.lock);
+			if (race.isSettled())
+				return false;
+			race.waiting = awaiting;
+			race.waiting_loop = &loop;
+			return true;
+		}
+
+		void await_resume() const noexcept {
+		}
+	};
+
+	/**
+	 * @brief Counts a newly launched request, unless the race is already settled.
+	 * @return False if the outcome is known and the request need not run.
+	 */
+	bool launch() {
+		std::lock_guard<std::mutex> guard(lock);
+		if (launched > 0 && isSettled())
+			return false;
+		launched++;
+		return true;
+	}
+
+	/**
+	 * @brief Checks whether a request succeeded or every launched one failed.
+	 * @return True if the race is settled.
+	 */
+	bool done() {
+		std::lock_guard<std::mutex> guard(lock);
+		return isSettled();
+	}
+
+	/**
+	 * @brief Reports a success; later successes are dropped.
+	 * @param value The request's result.
+	 */
+	void succeed(Result &&value) {
+		std::unique_lock<std::mutex> guard(lock);
+		if (!result)
+			result.emplace(std::move(value));
+		wakeIfSettled(guard);
+	}
+
+	/**
+	 * @brief Reports a failure.
+	 * @param reason The request's exception.
+	 */
+	void fail(std::exception_ptr reason) {
+		std::unique_lock<std::mutex> guard(lock);
+		error = reason;
+		failed++;
+		wakeIfSettled(guard);
+	}
+
+	/**
+	 * @brief Waits on a loop for the outcome.
+	 * @param loop The loop the awaiting coroutine is resumed on.
+	 * @return Awaitable; take() then returns at once.
+	 */
+	Settled settledOn(EventLoop &loop) {
+		return Settled { *this, loop };
+	}
+
+	/**
+	 * @brief Waits for the outcome.
+	 * @return The first successful result.
+	 * @throws The last failure's exception if every request failed.
+	 */
+	Result take() {
+		std::unique_lock<std::mutex> guard(lock);
+		settled.wait(guard, [this] {
+			return isSettled();
+		});
+		if (!result)
+			std::rethrow_exception(error);
+		return std::move(*result);
+	}
+};
+
+/**
+ * @class Hedger
+ * @brief Hedges the search calls of one provider.
+ * @details Blocking requests run on a WorkerPool shared by every hedger while the caller
+ *          of call() waits for the outcome; coroutine requests run on the caller's loop.
+ *          Once the provider's p95 latency is known, a timer on the EventLoop fires after
+ *          it; if the request has not answered by then and the hedge budget allows, an
+ *          identical request is started next to it and the caller returns with the first
+ *          to succeed, leaving the slow one behind. Every request records its own
+ *          latency, so the p95 keeps tracking the provider rather than the hedged outcome.
+ *
+ *          Requests must capture everything they use by value, since a losing request may
+ *          outlive the call.
+ */
+class Hedger {
+private:
+	/// Recent latencies of the provider, shared with in-flight requests.
+	std::shared_ptr<LatencyTracker> latencies;
+	/// Largest fraction of calls that may be hedged, 0 when hedging is off.
+	double budget;
+	/// Calls made through this hedger.
+	std::atomic<std::uint64_t> calls { };
+	/// Calls that were hedged.
+	std::atomic<std::uint64_t> hedges { };
+
+	/// Samples needed before the p95 is trusted.
+	static const std::size_t MIN_SAMPLES = 20;
+
+	/**
+	 * @brief Takes a hedge from the budget if one is left.
+	 * @return True if the call may be hedged.
+	 */
+	bool takeHedge();
+
+	/**
+	 * @brief Runs a blocking request on the pool shared by every hedger.
+	 * @param request The request, reporting to its race.
+	 */
+	static void startAttempt(std::function<void()> request);
+
+	/**
+	 * @brief Runs one blocking request and reports it to the race.
+	 */
+	template<typename Result>
+	static void attempt(const std::shared_ptr<HedgeRace<Result>> &race,
+			const std::function<Result()> &request,
+			const std::shared_ptr<LatencyTracker> &tracker) {
+		auto start = std::chrono::steady_clock::now();
+		try {
+			Result value = request();
+			tracker->record(std::chrono::duration_cast<std::chrono::microseconds>(
+					std::chrono::steady_clock::now() - start));
+			race->succeed(std::move(value));
+		} catch (...) {
+			race->fail(std::current_exception());
+		}
+	}
+
+	/**
+	 * @brief Runs one coroutine request and reports it to the race.
+	 */
+	template<typename Result>
+	static Detached attemptAsync(std::shared_ptr<HedgeRace<Result>> race,
+			std::function<Task<Result>()> request,
+			std::shared_ptr<LatencyTracker> tracker) {
+		auto start = std::chrono::steady_clock::now();
+		try {
+			Task<Result> attempt = request();
+			Result value = co_await attempt;
+			tracker->record(std::chrono::duration_cast<std::chrono::microseconds>(
+					std::chrono::steady_clock::now() - start));
+			race->succeed(std::move(value));
+		} catch (...) {
+			race->fail(std::current_exception());
+		}
+	}
+
+	/**
+	 * @brief Waits on the loop for the p95, then hedges a blocking request still running.
+	 */
+	template<typename Result>
+	Detached hedgeAfter(EventLoop &loop, std::chrono::microseconds delay,
+			std::shared_ptr<HedgeRace<Result>> race,
+			std::function<Result()> request) {
+		EventLoop::Sleep timer = loop.sleepFor(delay);
+		co_await timer;
+		if (race->done() || !takeHedge() || !race->launch())
+			co_return;
+		startAttempt([race, request, tracker = latencies] {
+			attempt(race, request, tracker);
+		});
+	}
+
+	/**
+	 * @brief Waits on the loop for the p95, then hedges a coroutine request still running.
+	 */
+	template<typename Result>
+	Detached hedgeAfterAsync(EventLoop &loop, std::chrono::microseconds delay,
+			std::shared_ptr<HedgeRace<Result>> race,
+			std::function<Task<Result>()> request) {
+		EventLoop::Sleep timer = loop.sleepFor(delay);
+		co_await timer;
+		if (race->done() || !takeHedge() || !race->launch())
+			co_return;
+		attemptAsync(race, request, latencies);
+	}
+
+public:
+	/**
+	 * @brief Creates a hedger with the budget from EXPEDIA_HEDGE_BUDGET.
+	 */
+	Hedger();
+
+	/**
+	 * @brief Creates a hedger with an explicit budget.
+	 * @param budget Largest fraction of calls that may be hedged, 0 to disable.
+	 */
+	explicit Hedger(double budget);
+
+	/**
+	 * @brief Checks whether calls are hedged.
+	 * @return True if the budget is above zero.
+	 */
+	bool enabled() const;
+
+	/**
+	 * @brief Runs a request, hedging it if it is slow, and waits for the first success.
+	 * @param request The provider call.
+	 * @return The first successful result.
+	 * @throws The request's exception if every attempt failed.
+	 */
+	template<typename Result>
+	Result call(const std::function<Result()> &request) {
+		if (!enabled())
+			return request();
+		calls++;
+		auto race = std::make_shared<HedgeRace<Result>>();
+		race->launch();
+		//the caller only waits, so a hedge that wins returns before the slow request.
+		startAttempt([race, request, tracker = latencies] {
+			attempt(race, request, tracker);
+		});
+		//until the p95 is known, never hedge.
+		if (latencies->count() >= MIN_SAMPLES)
+			hedgeAfter(EventLoop::instance(), latencies->percentile(0.95), race,
+					request);
+		return race->take();
+	}
+
+	/**
+	 * @brief Runs a coroutine request on the loop, hedging it if it is slow.
+	 * @param loop The loop the request and its hedge run on.
+	 * @param request Starts the provider call.
+	 * @return The first successful result.
+	 * @throws The request's exception if every attempt failed.
+	 */
+	template<typename Result>
+	Task<Result> callAsync(EventLoop &loop,
+			std::function<Task<Result>()> request) {
+		if (!enabled()) {
+			Task<Result> only = request();
+			Result value = co_await only;
+			co_return value;
+		}
+		calls++;
+		auto race = std::make_shared<HedgeRace<Result>>();
+		race->launch();
+		attemptAsync(race, request, latencies);
+		if (latencies->count() >= MIN_SAMPLES)
+			hedgeAfterAsync(loop, latencies->percentile(0.95), race, request);
+		typename HedgeRace<Result>::Settled settled = race->settledOn(loop);
+		co_await settled;
+		co_return race->take();
+	}
+
+	/**
+	 * @brief Gets the number of calls hedged so far.
+	 * @return Hedge count.
+	 */
+	std::uint64_t hedgeCount() const;
+
+	/**
+	 * @brief Gets the provider's observed latency percentile.
+	 * @param fraction The percentile as a fraction (0.95 for p95).
+	 * @return The latency.
+	 */
+	std::chrono::microseconds percentile(double fraction) const;
+};
+
+#endif /* HEADERS_HEDGED_CALL_HPP_ */
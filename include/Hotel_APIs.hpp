@@ -4,7 +4,8 @@
  * @details Provides classes for:
  *          - Hotel customer information (HiltonCustomerInfo, MarriottCustomerInfo)
  *          - Room details (HiltonRoom, MarriottFoundRoom)
- *          - API operations (HiltonHotelAPI, MarriottHotelAPI)
+ *          - API operations (HiltonHotelAPI, MarriottHotelAPI), blocking or as coroutines
+ *            run on an EventLoop
  *
  * @author Abdallah Salem
  */
@@ -14,6 +15,9 @@
 
 #include<iostream>
 #include<vector>
+#include "Date.hpp"
+#include "Money.hpp"
+#include "Async_Call.hpp"
 
 /**
  * @class HiltonCustomerInfo
@@ -23,8 +27,8 @@ class HiltonCustomerInfo {
 public:
 	std::string country; ///< Country of the hotel location
 	std::string city;    ///< City of the hotel location
-	std::string date_from; ///< Check-in date (e.g., "2025-06-01")
-	std::string date_to;   ///< Check-out date (e.g., "2025-06-05")
+	Date date_from; ///< Check-in date (e.g., "01-06-2025")
+	Date date_to;   ///< Check-out date (e.g., "05-06-2025")
 	int needed_rooms { };  ///< Number of rooms required
 	int adults { };        ///< Number of adults
 	int children { };      ///< Number of children
@@ -49,7 +53,7 @@ public:
 	 * @param number_of_nights Duration of stay in nights.
 	 */
 	HiltonCustomerInfo(std::string country, std::string city,
-			std::string date_from, std::string date_to, int needed_rooms,
+			Date date_from, Date date_to, int needed_rooms,
 			int adults, int children, int number_of_nights);
 };
 
@@ -61,9 +65,9 @@ class HiltonRoom {
 public:
 	std::string room_type; ///< Type of room (e.g., "Single", "Suite")
 	int available_number { }; ///< Number of such rooms available
-	double price_per_night { }; ///< Price per night for the room
-	std::string from_date; ///< Start date of availability
-	std::string to_date;   ///< End date of availability
+	Money price_per_night; ///< Price per night for the room
+	Date from_date; ///< Start date of availability
+	Date to_date;   ///< End date of availability
 
 	/**
 	 * @brief Default constructor.
@@ -80,8 +84,8 @@ public:
 	 * @param from The start date of availability.
 	 * @param to The end date of availability.
 	 */
-	HiltonRoom(std::string room_type, int available_number, double price,
-			std::string from, std::string to);
+	HiltonRoom(std::string room_type, int available_number, Money price,
+			Date from, Date to);
 };
 
 /**
@@ -121,6 +125,35 @@ public:
 	 */
 	static bool cancelReservation(const HiltonCustomerInfo &customer_info,
 			const HiltonRoom &room_info);
+
+	/**
+	 * @brief Searches for rooms without holding a thread while waiting.
+	 * @param loop The loop the call waits on.
+	 * @param customer_info The customer's booking preferences.
+	 * @return A vector of available HiltonRoom objects.
+	 */
+	static Task<std::vector<HiltonRoom>> searchRoomsAsync(EventLoop &loop,
+			HiltonCustomerInfo customer_info);
+
+	/**
+	 * @brief Reserves a room without holding a thread while waiting.
+	 * @param loop The loop the call waits on.
+	 * @param customer_info The customer's information.
+	 * @param room_info The room to reserve.
+	 * @return True if the reservation is successful, false otherwise.
+	 */
+	static Task<bool> reserveRoomAsync(EventLoop &loop,
+			HiltonCustomerInfo customer_info, HiltonRoom room_info);
+
+	/**
+	 * @brief Cancels a reservation without holding a thread while waiting.
+	 * @param loop The loop the call waits on.
+	 * @param customer_info The customer's information.
+	 * @param room_info The room to cancel the reservation for.
+	 * @return True if the cancellation is successful, false otherwise.
+	 */
+	static Task<bool> cancelReservationAsync(EventLoop &loop,
+			HiltonCustomerInfo customer_info, HiltonRoom room_info);
 };
 
 /**
@@ -131,9 +164,9 @@ class MarriottFoundRoom {
 public:
 	std::string room_type; ///< Type of room (e.g., "Double", "Deluxe")
 	int available_number { }; ///< Number of such rooms available
-	double price_per_night { }; ///< Price per night for the room
-	std::string date_from { }; ///< Start date of availability
-	std::string date_to { };   ///< End date of availability
+	Money price_per_night; ///< Price per night for the room
+	Date date_from { }; ///< Start date of availability
+	Date date_to { };   ///< End date of availability
 
 	/**
 	 * @brief Default constructor.
@@ -150,8 +183,8 @@ public:
 	 * @param from The start date of availability.
 	 * @param to The end date of availability.
 	 */
-	MarriottFoundRoom(std::string type, int available_number, double price,
-			std::string from, std::string to);
+	MarriottFoundRoom(std::string type, int available_number, Money price,
+			Date from, Date to);
 };
 
 /**
@@ -162,8 +195,8 @@ class MarriottCustomerInfo {
 public:
 	std::string country; ///< Country of the hotel location
 	std::string city;    ///< City of the hotel location
-	std::string date_from; ///< Check-in date (e.g., "2025-06-01")
-	std::string date_to;   ///< Check-out date (e.g., "2025-06-05")
+	Date date_from; ///< Check-in date (e.g., "01-06-2025")
+	Date date_to;   ///< Check-out date (e.g., "05-06-2025")
 	int needed_rooms { };  ///< Number of rooms required
 	int adults { };        ///< Number of adults
 	int children { };      ///< Number of children
@@ -188,7 +221,7 @@ public:
 	 * @param number_of_nights Duration of stay in nights.
 	 */
 	MarriottCustomerInfo(std::string country, std::string city,
-			std::string date_from, std::string date_to, int needed_rooms,
+			Date date_from, Date date_to, int needed_rooms,
 			int adults, int children, int number_of_nights);
 };
 
@@ -229,6 +262,35 @@ public:
 	 */
 	static bool cancelReservation(const MarriottFoundRoom &room_info,
 			const MarriottCustomerInfo &customer_info);
+
+	/**
+	 * @brief Finds rooms without holding a thread while waiting.
+	 * @param loop The loop the call waits on.
+	 * @param customer_info The customer's booking preferences.
+	 * @return A vector of available MarriottFoundRoom objects.
+	 */
+	static Task<std::vector<MarriottFoundRoom>> findRoomsAsync(EventLoop &loop,
+			MarriottCustomerInfo customer_info);
+
+	/**
+	 * @brief Reserves a room without holding a thread while waiting.
+	 * @param loop The loop the call waits on.
+	 * @param room_info The room to reserve.
+	 * @param customer_info The customer's information.
+	 * @return True if the reservation is successful, false otherwise.
+	 */
+	static Task<bool> reserveRoomAsync(EventLoop &loop,
+			MarriottFoundRoom room_info, MarriottCustomerInfo customer_info);
+
+	/**
+	 * @brief Cancels a reservation without holding a thread while waiting.
+	 * @param loop The loop the call waits on.
+	 * @param room_info The room to cancel the reservation for.
+	 * @param customer_info The customer's information.
+	 * @return True if the cancellation is successful, false otherwise.
+	 */
+	static Task<bool> cancelReservationAsync(EventLoop &loop,
+			MarriottFoundRoom room_info, MarriottCustomerInfo customer_info);
 };
 
 #endif /* HEADERS_HOTEL_APIS_HPP_ */
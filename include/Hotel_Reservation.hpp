@@ -3,8 +3,9 @@
  * @brief Abstract base class for hotel reservations
  * @details Declares interface for:
  *          - Setting customer information
- *          - Retrieving available rooms
+ *          - Retrieving available rooms, as records or into a columnar buffer
  *          - Making/canceling reservations
+ *          - Coroutine room search for use on an EventLoop
  *
  * @author Abdallah Salem
  */
@@ -14,6 +15,14 @@
 
 #include "Reservation.hpp"
 #include "Hotel_Reservation_Info.hpp"
+#include "Result_Columns.hpp"
+#include <functional>
+
+/**
+ * @typedef RoomBatch
+ * @brief Receiver of one batch of rooms found by an adapter.
+ */
+typedef std::function<void(std::vector<FoundRoomInfo>&&)> RoomBatch;
 
 /**
  * @class HotelReservation
@@ -25,9 +34,11 @@ class HotelReservation: public Reservation {
 public:
 	/**
 	 * @brief Sets the customer information for the reservation.
-	 * @param info A unique pointer to a CustomerInfo object containing customer details.
+	 * @details The request is shared, not copied; it is converted to the chain's format
+	 *          only when the chain is called.
+	 * @param info A shared pointer to a CustomerInfo object containing customer details.
 	 */
-	virtual void setCustomerInfo(CustomerInfo_ptr &&info) = 0;
+	virtual void setCustomerInfo(CustomerQuery info) = 0;
 
 	/**
 	 * @brief Retrieves available rooms for the reservation.
@@ -35,6 +46,49 @@ public:
 	 */
 	virtual void getAvailableRooms(std::vector<FoundRoomInfo> &&rooms) = 0;
 
+	/**
+	 * @brief Appends available rooms to a columnar result buffer.
+	 * @details The default goes through getAvailableRooms(); adapters override it to
+	 *          write their answer straight into the columns.
+	 * @param columns Buffer the rooms are appended to.
+	 */
+	virtual void appendAvailableRooms(RoomColumns &columns) {
+		std::vector<FoundRoomInfo> rooms;
+		getAvailableRooms(std::move(rooms));
+		columns.reserve(columns.size() + rooms.size());
+		for (const FoundRoomInfo &room : rooms)
+			columns.append(room);
+	}
+
+	/**
+	 * @brief Delivers the available rooms within a filter's bounds in batches as they
+	 *        are found.
+	 * @details The default filters the columns of appendAvailableRooms() and hands over
+	 *          the rooms kept as one batch; adapters able to answer piecemeal override it.
+	 * @param filter Bounds the rooms are kept within.
+	 * @param batch Receiver called once per batch.
+	 */
+	virtual void streamAvailableRooms(const RoomFilter &filter,
+			const RoomBatch &batch) {
+		RoomColumns columns;
+		appendAvailableRooms(columns);
+		batch(columns.rows(filter.select(columns)));
+	}
+
+	/**
+	 * @brief Retrieves available rooms without holding a thread while the hotel answers.
+	 * @details The default runs getAvailableRooms() on the loop thread; adapters override
+	 *          it to await their hotel. The reservation must outlive the task.
+	 * @param loop The loop the call waits on.
+	 * @return The available rooms.
+	 */
+	virtual Task<std::vector<FoundRoomInfo>> getAvailableRoomsAsync(
+			[[maybe_unused]] EventLoop &loop) {
+		std::vector<FoundRoomInfo> rooms;
+		getAvailableRooms(std::move(rooms));
+		co_return rooms;
+	}
+
 	/**
 	 * @brief Sets the chosen room information for the reservation.
 	 * @param room_info A unique pointer to a FoundRoomInfo object containing room details.
@@ -43,15 +97,19 @@ public:
 
 	/**
 	 * @brief Makes a hotel reservation based on the provided information.
+	 * @details The blocking makeReservation() waits on it.
+	 * @param loop The loop the call waits on.
 	 * @return True if the reservation is successful, false otherwise.
 	 */
-	virtual bool makeReservation() = 0;
+	virtual Task<bool> makeReservationAsync(EventLoop &loop) = 0;
 
 	/**
 	 * @brief Cancels an existing hotel reservation.
+	 * @details The blocking cancelReservation() waits on it.
+	 * @param loop The loop the call waits on.
 	 * @return True if the cancellation is successful, false otherwise.
 	 */
-	virtual bool cancelReservation() = 0;
+	virtual Task<bool> cancelReservationAsync(EventLoop &loop) = 0;
 
 	/**
 	 * @brief Virtual destructor for HotelReservation.
@@ -13,6 +13,9 @@
 
 #include <iostream>
 #include <memory>
+#include "Date.hpp"
+#include "Money.hpp"
+#include "Provider_Registry.hpp"
 
 /**
  * @class FoundRoomInfo
@@ -20,18 +23,18 @@
  */
 class FoundRoomInfo {
 public:
-	/// Name of the hotel.
-	std::string hotel;
+	/// Interned ID of the hotel chain.
+	ProviderId hotel { };
 	/// Check-in date for the reservation.
-	std::string from_date;
+	Date from_date;
 	/// Check-out date for the reservation.
-	std::string to_date;
+	Date to_date;
 	/// Type of view for the room (e.g., sea view, city view).
 	std::string view_type;
 	/// Number of rooms available.
 	int how_many { };
 	/// Price per night for the room.
-	double price_for_night { };
+	Money price_for_night;
 
 	/**
 	 * @brief Default constructor for FoundRoomInfo.
@@ -40,15 +43,15 @@ public:
 
 	/**
 	 * @brief Parameterized constructor for FoundRoomInfo.
-	 * @param hotel Name of the hotel.
+	 * @param hotel ID of the hotel chain.
 	 * @param from_date Check-in date.
 	 * @param to_date Check-out date.
 	 * @param view_type Type of room view.
 	 * @param how_many Number of rooms available.
 	 * @param price Price per night for the room.
 	 */
-	FoundRoomInfo(std::string hotel, std::string from_date, std::string to_date,
-			std::string view_type, int how_many, double price);
+	FoundRoomInfo(ProviderId hotel, Date from_date, Date to_date,
+			std::string view_type, int how_many, Money price);
 
 	/**
 	 * @brief Copy constructor for FoundRoomInfo.
@@ -84,9 +87,9 @@ public:
 class CustomerInfo {
 public:
 	/// Check-in date for the reservation.
-	std::string from_date;
+	Date from_date;
 	/// Check-out date for the reservation.
-	std::string to_date;
+	Date to_date;
 	/// Country where the hotel is located.
 	std::string country;
 	/// City where the hotel is located.
@@ -116,9 +119,9 @@ public:
 	 * @param needed_rooms Number of rooms needed.
 	 * @param number_of_nights Number of nights for the stay.
 	 */
-	CustomerInfo(std::string from_date, std::string to_date,
-			std::string country, std::string city, int children, int adults,
-			int needed_rooms, int number_of_nights);
+	CustomerInfo(Date from_date, Date to_date, std::string country,
+			std::string city, int children, int adults, int needed_rooms,
+			int number_of_nights);
 
 	/**
 	 * @brief Copy constructor for CustomerInfo.
@@ -159,4 +162,12 @@ typedef std::unique_ptr<FoundRoomInfo> RoomInfo_ptr;
  */
 typedef std::unique_ptr<CustomerInfo> CustomerInfo_ptr;
 
+/**
+ * @typedef CustomerQuery
+ * @brief Shared, read-only customer request.
+ * @details One request is read by every hotel adapter of a search and by the
+ *          reservation booked from it, instead of each of them copying it.
+ */
+typedef std::shared_ptr<const CustomerInfo> CustomerQuery;
+
 #endif /* HEADERS_HOTEL_RESERVATION_INFO_HPP_ */
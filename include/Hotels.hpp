@@ -4,7 +4,7 @@
  * @details Contains:
  *          - HiltonHotelReservation: Adapter for Hilton API
  *          - MarriottHotelReservation: Adapter for Marriott API
- *          - Defines smart pointer types for hotel-specific objects
+ *          - Both read the shared customer request, converting it only at the API call
  * @author Abdallah Salem
  * @date Created: Apr 13, 2025
  */
@@ -14,42 +14,25 @@
 
 #include "Hotel_APIs.hpp"
 #include "Hotel_Reservation.hpp"
-
-/**
- * @typedef HiltonCustomerInfo_ptr
- * @brief Smart pointer to a HiltonCustomerInfo object.
- */
-typedef std::unique_ptr<HiltonCustomerInfo> HiltonCustomerInfo_ptr;
-
-/**
- * @typedef HiltonRoom_ptr
- * @brief Smart pointer to a HiltonRoom object.
- */
-typedef std::unique_ptr<HiltonRoom> HiltonRoom_ptr;
-
-/**
- * @typedef MarriottCustomerInfo_ptr
- * @brief Smart pointer to a MarriottCustomerInfo object.
- */
-typedef std::unique_ptr<MarriottCustomerInfo> MarriottCustomerInfo_ptr;
-
-/**
- * @typedef MarriottFoundRoom_ptr
- * @brief Smart pointer to a MarriottFoundRoom object.
- */
-typedef std::unique_ptr<MarriottFoundRoom> MarriottFoundRoom_ptr;
+#include "Search_Cache.hpp"
 
 /**
  * @class HiltonHotelReservation
  * @brief Class for managing Hilton hotel reservations.
  * @details Inherits from HotelReservation and implements functionality specific to Hilton hotels.
  */
-class HiltonHotelReservation: public HotelReservation {
+class HiltonHotelReservation final : public HotelReservation {
 private:
-	/// Smart pointer to Hilton-specific customer information.
-	HiltonCustomerInfo_ptr hilton_customer_info;
-	/// Smart pointer to the chosen Hilton room.
-	HiltonRoom_ptr hilton_chosen_room;
+	/// Shared request, put in Hilton's format at each API call.
+	CustomerQuery customer_query;
+	/// The chosen Hilton room.
+	HiltonRoom hilton_chosen_room;
+
+	/**
+	 * @brief Applies a booking change of this reservation to the cached availability.
+	 * @param rooms_taken Rooms taken (positive) or given back (negative).
+	 */
+	void reconcileAvailability(int rooms_taken) const;
 
 public:
 	/**
@@ -59,10 +42,10 @@ public:
 
 	/**
 	 * @brief Parameterized constructor for HiltonHotelReservation.
-	 * @param customer_info Smart pointer to customer information.
+	 * @param customer_info Shared pointer to customer information.
 	 * @param chosen_room Smart pointer to the chosen room information.
 	 */
-	HiltonHotelReservation(CustomerInfo_ptr &&customer_info,
+	HiltonHotelReservation(CustomerQuery customer_info,
 			RoomInfo_ptr &&chosen_room);
 
 	/**
@@ -93,16 +76,36 @@ public:
 
 	/**
 	 * @brief Sets the customer information for the Hilton reservation.
-	 * @param customer_info Smart pointer to customer information.
+	 * @details Keeps a reference to the shared request; it is converted to Hilton's
+	 *          format only when the API is called.
+	 * @param customer_info Shared pointer to customer information.
 	 */
-	void setCustomerInfo(CustomerInfo_ptr &&customer_info) override;
+	void setCustomerInfo(CustomerQuery customer_info) override;
 
 	/**
 	 * @brief Retrieves available rooms for the Hilton reservation.
+	 * @details Served from the Hilton availability cache when the same location and
+	 *          dates were searched recently.
 	 * @param rooms A vector of FoundRoomInfo objects representing available rooms.
 	 */
 	void getAvailableRooms(std::vector<FoundRoomInfo> &&rooms) override;
 
+	/**
+	 * @brief Appends this provider's answer to a columnar result buffer.
+	 * @details Shares the availability cache and hedger with getAvailableRooms().
+	 * @param columns Buffer the offers are appended to.
+	 */
+	void appendAvailableRooms(RoomColumns &columns) override;
+
+	/**
+	 * @brief Retrieves available rooms, awaiting the hotel on the loop.
+	 * @details Shares the availability cache and hedger with getAvailableRooms().
+	 * @param loop The loop the call waits on.
+	 * @return The available rooms.
+	 */
+	Task<std::vector<FoundRoomInfo>> getAvailableRoomsAsync(EventLoop &loop)
+			override;
+
 	/**
 	 * @brief Sets the chosen room information for the Hilton reservation.
 	 * @param room_info Smart pointer to the chosen room information.
@@ -111,15 +114,31 @@ public:
 
 	/**
 	 * @brief Makes a Hilton hotel reservation.
+	 * @details On success the cached availability of the chosen room is decremented.
+	 * @param loop The loop the call waits on.
 	 * @return True if the reservation is successful, false otherwise.
 	 */
-	bool makeReservation() override;
+	Task<bool> makeReservationAsync(EventLoop &loop) override;
 
 	/**
 	 * @brief Cancels a Hilton hotel reservation.
+	 * @details On success the cached availability of the chosen room is incremented.
+	 * @param loop The loop the call waits on.
 	 * @return True if the cancellation is successful, false otherwise.
 	 */
-	bool cancelReservation() override;
+	Task<bool> cancelReservationAsync(EventLoop &loop) override;
+
+	/**
+	 * @brief Gets the interned ID of this hotel chain, stamped on every search result.
+	 * @return The chain's ProviderId.
+	 */
+	static ProviderId providerId();
+
+	/**
+	 * @brief Reports the counters of the shared search pipeline of this hotel chain.
+	 * @return Cache hits, misses, evictions and size, and the coalesced searches.
+	 */
+	static SearchStats searchStats();
 
 	/**
 	 * @brief Creates a clone of the Hilton hotel reservation.
@@ -129,9 +148,9 @@ public:
 
 	/**
 	 * @brief Calculates the total cost of the Hilton reservation.
-	 * @return The total cost as a double.
+	 * @return The total cost.
 	 */
-	double getCost() const override;
+	Money getCost() const override;
 
 	/**
 	 * @brief Outputs the details of the Hilton reservation.
@@ -145,12 +164,18 @@ public:
  * @brief Class for managing Marriott hotel reservations.
  * @details Inherits from HotelReservation and implements functionality specific to Marriott hotels.
  */
-class MarriottHotelReservation: public HotelReservation {
+class MarriottHotelReservation final : public HotelReservation {
 private:
-	/// Smart pointer to Marriott-specific customer information.
-	MarriottCustomerInfo_ptr marriott_customer_info;
-	/// Smart pointer to the chosen Marriott room.
-	MarriottFoundRoom_ptr marriott_chosen_room;
+	/// Shared request, put in Marriott's format at each API call.
+	CustomerQuery customer_query;
+	/// The chosen Marriott room.
+	MarriottFoundRoom marriott_chosen_room;
+
+	/**
+	 * @brief Applies a booking change of this reservation to the cached availability.
+	 * @param rooms_taken Rooms taken (positive) or given back (negative).
+	 */
+	void reconcileAvailability(int rooms_taken) const;
 
 public:
 	/**
@@ -160,10 +185,10 @@ public:
 
 	/**
 	 * @brief Parameterized constructor for MarriottHotelReservation.
-	 * @param customer_info Smart pointer to customer information.
+	 * @param customer_info Shared pointer to customer information.
 	 * @param chosen_room Smart pointer to the chosen room information.
 	 */
-	MarriottHotelReservation(CustomerInfo_ptr &&customer_info,
+	MarriottHotelReservation(CustomerQuery customer_info,
 			RoomInfo_ptr &&chosen_room);
 
 	/**
@@ -194,16 +219,36 @@ public:
 
 	/**
 	 * @brief Sets the customer information for the Marriott reservation.
-	 * @param customer_info Smart pointer to customer information.
+	 * @details Keeps a reference to the shared request; it is converted to Marriott's
+	 *          format only when the API is called.
+	 * @param customer_info Shared pointer to customer information.
 	 */
-	void setCustomerInfo(CustomerInfo_ptr &&customer_info) override;
+	void setCustomerInfo(CustomerQuery customer_info) override;
 
 	/**
 	 * @brief Retrieves available rooms for the Marriott reservation.
+	 * @details Served from the Marriott availability cache when the same location and
+	 *          dates were searched recently.
 	 * @param rooms A vector of FoundRoomInfo objects representing available rooms.
 	 */
 	void getAvailableRooms(std::vector<FoundRoomInfo> &&rooms) override;
 
+	/**
+	 * @brief Appends this provider's answer to a columnar result buffer.
+	 * @details Shares the availability cache and hedger with getAvailableRooms().
+	 * @param columns Buffer the offers are appended to.
+	 */
+	void appendAvailableRooms(RoomColumns &columns) override;
+
+	/**
+	 * @brief Retrieves available rooms, awaiting the hotel on the loop.
+	 * @details Shares the availability cache and hedger with getAvailableRooms().
+	 * @param loop The loop the call waits on.
+	 * @return The available rooms.
+	 */
+	Task<std::vector<FoundRoomInfo>> getAvailableRoomsAsync(EventLoop &loop)
+			override;
+
 	/**
 	 * @brief Sets the chosen room information for the Marriott reservation.
 	 * @param room_info Smart pointer to the chosen room information.
@@ -212,15 +257,31 @@ public:
 
 	/**
 	 * @brief Makes a Marriott hotel reservation.
+	 * @details On success the cached availability of the chosen room is decremented.
+	 * @param loop The loop the call waits on.
 	 * @return True if the reservation is successful, false otherwise.
 	 */
-	bool makeReservation() override;
+	Task<bool> makeReservationAsync(EventLoop &loop) override;
 
 	/**
 	 * @brief Cancels a Marriott hotel reservation.
+	 * @details On success the cached availability of the chosen room is incremented.
+	 * @param loop The loop the call waits on.
 	 * @return True if the cancellation is successful, false otherwise.
 	 */
-	bool cancelReservation() override;
+	Task<bool> cancelReservationAsync(EventLoop &loop) override;
+
+	/**
+	 * @brief Gets the interned ID of this hotel chain, stamped on every search result.
+	 * @return The chain's ProviderId.
+	 */
+	static ProviderId providerId();
+
+	/**
+	 * @brief Reports the counters of the shared search pipeline of this hotel chain.
+	 * @return Cache hits, misses, evictions and size, and the coalesced searches.
+	 */
+	static SearchStats searchStats();
 
 	/**
 	 * @brief Creates a clone of the Marriott hotel reservation.
@@ -230,9 +291,9 @@ public:
 
 	/**
 	 * @brief Calculates the total cost of the Marriott reservation.
-	 * @return The total cost as a double.
+	 * @return The total cost.
 	 */
-	double getCost() const override;
+	Money getCost() const override;
 
 	/**
 	 * @brief Outputs the details of the Marriott reservation.
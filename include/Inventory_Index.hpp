@@ -0,0 +1,152 @@
+/**
+ * @file Inventory_Index.hpp
+ * @brief In-process index of provider inventory
+ * @details Provides:
+ *          - InventoryIndex: Offers bucketed by route or by location
+ *          - readInventoryFile: Line reader for the per-provider inventory files
+ *          - inventoryPath: Location of an inventory file
+ *          - parseInventoryNumber: Strict numeric field parsing
+ *
+ *          Inventory files are plain comma separated text, one offer per line; blank
+ *          lines and lines starting with '#' are ignored.
+ *
+ * @author Abdallah Salem
+ */
+#ifndef HEADERS_INVENTORY_INDEX_HPP_
+#define HEADERS_INVENTORY_INDEX_HPP_
+
+#include <vector>
+#include <string>
+#include <functional>
+#include <unordered_map>
+#include "Search_Cache.hpp"
+#include "Money.hpp"
+
+/**
+ * @class InventoryIndex
+ * @brief Inverted index from a two-part key to the offers filed under it.
+ * @details Flights are filed under (origin, destination) and rooms under (country, city),
+ *          both normalized like cache keys. A lookup is one hash probe and returns only the
+ *          matching bucket, so search cost follows the number of matches rather than the
+ *          size of the inventory. The index is filled once and read-only afterwards.
+ * @tparam Offer The provider's own offer type (e.g. AirCanadaFlight, HiltonRoom).
+ */
+template<typename Offer>
+class InventoryIndex {
+private:
+	/**
+	 * @brief Offers filed under one key, with the key terms as first written.
+	 */
+	struct Bucket {
+		std::string first;        ///< Origin or country.
+		std::string second;       ///< Destination or city.
+		std::vector<Offer> offers; ///< Offers under the key.
+	};
+
+	/// Buckets per normalized key.
+	std::unordered_map<std::string, Bucket> buckets;
+	/// Total number of offers.
+	std::size_t offers { };
+
+	/**
+	 * @brief Builds the bucket key of a pair of terms.
+	 */
+	static std::string key(const std::string &first, const std::string &second) {
+		return normalizeSearchText(first) + "|" + normalizeSearchText(second);
+	}
+
+public:
+	/**
+	 * @brief Files an offer under a key.
+	 * @param first Origin or country.
+	 * @param second Destination or city.
+	 * @param offer The offer.
+	 */
+	void add(const std::string &first, const std::string &second, Offer offer) {
+		Bucket &bucket = buckets[key(first, second)];
+		if (bucket.offers.empty()) {
+			bucket.first = first;
+			bucket.second = second;
+		}
+		bucket.offers.push_back(std::move(offer));
+		offers++;
+	}
+
+	/**
+	 * @brief Gets the offers filed under a key.
+	 * @param first Origin or country.
+	 * @param second Destination or city.
+	 * @return The matching offers, empty if none.
+	 */
+	const std::vector<Offer>& find(const std::string &first,
+			const std::string &second) const {
+		static const std::vector<Offer> none;
+		auto found = buckets.find(key(first, second));
+		return found == buckets.end() ? none : found->second.offers;
+	}
+
+	/**
+	 * @brief Visits every offer with the terms it is filed under.
+	 * @param visit Called with (first, second, offer) for each offer.
+	 */
+	void forEach(
+			const std::function<
+					void(const std::string&, const std::string&, const Offer&)> &visit) const {
+		for (const auto &entry : buckets)
+			for (const Offer &offer : entry.second.offers)
+				visit(entry.second.first, entry.second.second, offer);
+	}
+
+	/**
+	 * @brief Gets the total number of offers.
+	 * @return Offers across all keys.
+	 */
+	std::size_t size() const {
+		return offers;
+	}
+
+	/**
+	 * @brief Checks whether any offer was loaded.
+	 * @return True if the index is empty.
+	 */
+	bool empty() const {
+		return offers == 0;
+	}
+};
+
+/**
+ * @brief Builds the path of an inventory file.
+ * @details Files are looked up in the directory named by EXPEDIA_INVENTORY_DIR, or in
+ *          "data" relative to the working directory.
+ * @param file File name (e.g. "air_canada_flights.csv").
+ * @return The path.
+ */
+std::string inventoryPath(const std::string &file);
+
+/**
+ * @brief Reads an inventory file line by line.
+ * @param path Path of the file.
+ * @param row Called with the trimmed fields of each offer line; returns false to report
+ *            a malformed line, which is skipped.
+ * @return False if the file could not be opened.
+ */
+bool readInventoryFile(const std::string &path,
+		const std::function<bool(const std::vector<std::string>&)> &row);
+
+/**
+ * @brief Parses a price inventory field exactly.
+ * @param field The field text, in the default currency.
+ * @param value Receives the price.
+ * @return False if the field is not entirely an amount with at most two decimals.
+ */
+bool parseInventoryNumber(const std::string &field, Money &value);
+
+/**
+ * @brief Parses an integer inventory field.
+ * @param field The field text.
+ * @param value Receives the number.
+ * @return False if the field is not entirely an integer.
+ */
+bool parseInventoryNumber(const std::string &field, int &value);
+
+#endif /* HEADERS_INVENTORY_INDEX_HPP_ */
@@ -5,6 +5,10 @@
  *          - Composite reservation container
  *          - Cost calculation for multi-reservation trips
  *          - Output formatting for itinerary details
+ *          - Parallel booking of every sub-reservation
+ *          - Copies share their reservations until one of them changes
+ *          - Running totals of the whole trip, its flights and its hotels
+ *          - Reservations held inline as values, dispatched with std::visit
  *
  * @author Abdallah Salem
  */
@@ -14,17 +18,38 @@
 
 #include <vector>
 #include <sstream>
-#include "Reservation.hpp"
+#include "Reservation_Value.hpp"
 
 /**
  * @class Itinerary
  * @brief Class for managing a collection of reservations as an itinerary.
- * @details Inherits from Reservation and stores a vector of Reservation_ptr objects, providing methods to manage and query the itinerary.
+ * @details Inherits from Reservation and stores a vector of ReservationValue objects, providing methods to manage and query the itinerary.
+ *          Flights and hotels are held inline, so costs and details are visited without a
+ *          virtual call or a pointer per reservation.
  */
 class Itinerary: public Reservation {
 private:
-	/// Vector of smart pointers to Reservation objects.
-	std::vector<Reservation_ptr> Reservations;
+	/// Reservations, shared with copies of the itinerary until one of them changes; null when empty.
+	std::shared_ptr<std::vector<ReservationValue>> Reservations;
+	/// Cost of every reservation, kept up to date as reservations are added.
+	Money total_cost;
+	/// Cost of the flights, nested itineraries included.
+	Money flights_cost;
+	/// Cost of the hotel rooms, nested itineraries included.
+	Money hotels_cost;
+
+	/**
+	 * @brief Adds a reservation's cost to the running totals.
+	 * @param reservation The reservation just added.
+	 */
+	void addCost(const ReservationValue &reservation);
+
+	/**
+	 * @brief Gets the reservations for a change, copying the list first if a copy of the
+	 *        itinerary shares it.
+	 * @return The itinerary's own list.
+	 */
+	std::vector<ReservationValue>& ownReservations();
 
 public:
 	/**
@@ -34,6 +59,7 @@ public:
 
 	/**
 	 * @brief Copy constructor for Itinerary.
+	 * @details Shares the other itinerary's reservations; nothing is cloned.
 	 * @param other Another Itinerary object to copy from.
 	 */
 	Itinerary(const Itinerary &other);
@@ -60,12 +86,26 @@ public:
 
 	/**
 	 * @brief Adds a reservation to the itinerary.
-	 * @param reservation Smart pointer to a Reservation object to add.
+	 * @param reservation Smart pointer to a Reservation object to add; the itinerary takes it
+	 *        over, moving flights and hotels inline.
 	 */
-	void addReservation(const Reservation_ptr &reservation);
+	void addReservation(Reservation_ptr &&reservation);
+
+	/**
+	 * @brief Adds a reservation already held by another itinerary.
+	 * @param reservation The reservation value, copied in.
+	 */
+	void addReservation(const ReservationValue &reservation);
+
+	/**
+	 * @brief Gets the reservations for reading.
+	 * @return The reservations, empty if there are none.
+	 */
+	const std::vector<ReservationValue>& reservations() const;
 
 	/**
 	 * @brief Clears all reservations from the itinerary.
+	 * @details Copies sharing the reservations keep them.
 	 */
 	void clear();
 
@@ -82,13 +122,49 @@ public:
 	void getDetails(std::ostream &&get) const override;
 
 	/**
-	 * @brief Calculates the total cost of all reservations in the itinerary.
-	 * @return The total cost as a double.
+	 * @brief Gets the total cost of all reservations in the itinerary.
+	 * @details The total is kept as reservations are added, so this does not depend on
+	 *          their number.
+	 * @return The total cost.
+	 */
+	Money getCost() const;
+
+	/**
+	 * @brief Gets the cost of the flights of the itinerary.
+	 * @return The flights' cost, connecting flights included.
 	 */
-	double getCost() const;
+	Money getFlightsCost() const;
+
+	/**
+	 * @brief Gets the cost of the hotel rooms of the itinerary.
+	 * @return The rooms' cost.
+	 */
+	Money getHotelsCost() const;
+
+	/**
+	 * @brief Books every sub-reservation concurrently.
+	 * @details If any booking fails, the ones that were made are cancelled again.
+	 * @param loop The loop the calls wait on.
+	 * @return True if every sub-reservation is booked, false otherwise.
+	 */
+	Task<bool> makeReservationAsync(EventLoop &loop) override;
+
+	/**
+	 * @brief Cancels every sub-reservation concurrently.
+	 * @param loop The loop the calls wait on.
+	 * @return True if every sub-reservation is canceled, false otherwise.
+	 */
+	Task<bool> cancelReservationAsync(EventLoop &loop) override;
+
+	/**
+	 * @brief Collects the bookings of every sub-reservation, nested itineraries included.
+	 * @param bookings Receives the single reservations in itinerary order.
+	 */
+	void appendBookings(std::vector<Reservation*> &bookings) override;
 
 	/**
 	 * @brief Creates a clone of the itinerary.
+	 * @details The clone shares the reservations, so this does not depend on their number.
 	 * @return Smart pointer to a cloned Reservation object.
 	 */
 	Reservation_ptr clone() const override;
@@ -114,10 +190,16 @@ public:
  */
 typedef std::unique_ptr<Itinerary> Itinerary_ptr;
 
+/**
+ * @typedef SharedItinerary
+ * @brief Saved itinerary, shared by every copy of its user.
+ */
+typedef std::shared_ptr<const Itinerary> SharedItinerary;
+
 /**
  * @class Sum
  * @brief Functor for accumulating the total cost of reservations.
- * @tparam T The type used for summing costs (e.g., double).
+ * @tparam T The type used for summing costs (e.g., Money).
  */
 template<typename T>
 struct Sum {
@@ -126,10 +208,10 @@ struct Sum {
 
 	/**
 	 * @brief Function call operator to add a reservation's cost to the sum.
-	 * @param reservation Smart pointer to a Reservation object whose cost is added.
+	 * @param reservation The reservation whose cost is added.
 	 */
-	void operator()(const Reservation_ptr &reservation) {
-		sum += reservation->getCost();
+	void operator()(const ReservationValue &reservation) {
+		sum += getCost(reservation);
 	}
 };
 
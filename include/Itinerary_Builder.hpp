@@ -4,6 +4,8 @@
  * @details Provides:
  *          - Itinerary construction from flight/hotel reservations
  *          - Itinerary validation and clearing
+ *          - A session arena for the search scratch, released when the itinerary is
+ *            saved or cancelled
  *
  * @author Abdallah Salem
  */
@@ -22,8 +24,9 @@
  */
 class ItineraryBuilder {
 private:
+	SessionArena arena;       ///< Scratch of the searches of the current itinerary.
 	Itinerary_ptr it;         ///< Pointer to the current itinerary being built.
-	MakeReservation_ptr reserve; ///< Pointer to the reservation factory.
+	MakeReservation_ptr reserve; ///< Pointer to the reservation factory (uses the arena).
 
 public:
 	/**
@@ -64,7 +67,12 @@ public:
 	void addHotel();
 
 	/**
-	 * @brief Clears the current itinerary.
+	 * @brief Adds a multi-leg flight connection to the itinerary.
+	 */
+	void addConnectingFlight();
+
+	/**
+	 * @brief Clears the current itinerary and releases the session arena.
 	 */
 	void clearItinerary();
 
@@ -0,0 +1,111 @@
+/**
+ * @file Itinerary_Commit.hpp
+ * @brief Parallel booking of an itinerary with compensation
+ * @details Provides:
+ *          - BookingState: What happened to one booking of a commit
+ *          - CommitOutcome: Per-booking states of a commit or a rollback
+ *          - ItineraryCommit: Books every part of a reservation at once, cancelling the
+ *            booked parts if any part fails
+ *
+ * @author Abdallah Salem
+ */
+#ifndef HEADERS_ITINERARY_COMMIT_HPP_
+#define HEADERS_ITINERARY_COMMIT_HPP_
+
+#include <vector>
+#include "Reservation.hpp"
+
+/**
+ * @enum BookingState
+ * @brief What happened to one booking.
+ */
+enum class BookingState {
+	/// The provider confirmed the booking and it stands.
+	BOOKED,
+	/// The provider refused the booking.
+	FAILED,
+	/// The booking was made and then cancelled again.
+	COMPENSATED,
+	/// The booking was made but the provider refused to cancel it.
+	STRANDED
+};
+
+/**
+ * @class CommitOutcome
+ * @brief States of every booking of a commit, in itinerary order.
+ */
+class CommitOutcome {
+public:
+	/// State of each booking, in the order the itinerary lists them.
+	std::vector<BookingState> bookings;
+
+	/**
+	 * @brief Checks whether every booking stands.
+	 * @return True if all bookings were made, false otherwise.
+	 */
+	bool committed() const;
+
+	/**
+	 * @brief Counts the bookings that ended in a state.
+	 * @param state The state to count.
+	 * @return Number of bookings in that state.
+	 */
+	std::size_t count(BookingState state) const;
+};
+
+/**
+ * @class ItineraryCommit
+ * @brief Books all parts of a reservation in parallel, saga-style.
+ * @details Every part is booked concurrently on the event loop, so a trip costs about one
+ *          provider round-trip however many segments it has, without a thread per segment.
+ *          If any part fails, the parts that were booked are cancelled, again concurrently,
+ *          and the outcome tells which of them the providers would not release.
+ */
+class ItineraryCommit {
+private:
+	/**
+	 * @brief Books or cancels every booking concurrently.
+	 * @param loop The loop the calls wait on.
+	 * @param bookings The reservations to call.
+	 * @param book True to book them, false to cancel them; an exception counts as a refusal.
+	 * @return Whether each call succeeded, in booking order.
+	 */
+	static Task<std::vector<bool>> runAll(EventLoop &loop,
+			const std::vector<Reservation*> &bookings, bool book);
+
+public:
+	/**
+	 * @brief Books every part of a reservation, undoing them all on any failure.
+	 * @details Blocks until the shared event loop has run commitAsync().
+	 * @param reservation The reservation or itinerary to book.
+	 * @return The state of each part.
+	 */
+	static CommitOutcome commit(Reservation &reservation);
+
+	/**
+	 * @brief Cancels every part of a booked reservation.
+	 * @param reservation The reservation or itinerary to release.
+	 * @return COMPENSATED or STRANDED for each part.
+	 */
+	static CommitOutcome cancel(Reservation &reservation);
+
+	/**
+	 * @brief Books every part of a reservation without blocking, as commit() does.
+	 * @param loop The loop the calls wait on.
+	 * @param reservation The reservation or itinerary to book; must outlive the task.
+	 * @return The state of each part.
+	 */
+	static Task<CommitOutcome> commitAsync(EventLoop &loop,
+			Reservation &reservation);
+
+	/**
+	 * @brief Cancels every part of a reservation without blocking, as cancel() does.
+	 * @param loop The loop the calls wait on.
+	 * @param reservation The reservation or itinerary to release; must outlive the task.
+	 * @return COMPENSATED or STRANDED for each part.
+	 */
+	static Task<CommitOutcome> cancelAsync(EventLoop &loop,
+			Reservation &reservation);
+};
+
+#endif /* HEADERS_ITINERARY_COMMIT_HPP_ */
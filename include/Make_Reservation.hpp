@@ -3,15 +3,24 @@
  * @brief Reservation creation interface
  * @details Provides:
  *          - Unified interface for flight/hotel reservations
- *          - Reservation factory for creating concrete reservation objects
+ *          - Reservation factory for creating concrete reservation objects, dispatched by provider ID
+ *          - Parallel search across all registered providers
+ *          - Multi-leg connections across airlines, booked as an itinerary of flights
+ *          - Ranked, paginated presentation of the results, the first page streamed in
+ *            as providers answer
+ *          - Search scratch drawn from the builder's session arena
  *
  * @author Abdallah Salem
  */
 #ifndef HEADERS_MAKE_RESERVATION_HPP_
 #define HEADERS_MAKE_RESERVATION_HPP_
 
-#include "Hotels.hpp"
-#include "Airports.hpp"
+#include "Adapter_Registry.hpp"
+#include "Search_Fan_Out.hpp"
+#include "Ranked_Results.hpp"
+#include "Connection_Search.hpp"
+#include "Itinerary.hpp"
+#include "Session_Arena.hpp"
 
 /**
  * @class MakeReservation
@@ -21,31 +30,47 @@
  */
 class MakeReservation {
 private:
-	/// Vector of smart pointers to flight reservations.
+	/// Search adapters of the enabled airlines, built on the first flight search.
 	std::vector<FlightReservation_ptr> Airports;
-	/// Vector of smart pointers to hotel reservations.
+	/// Search adapters of the enabled hotel chains, built on the first room search.
 	std::vector<HotelReservation_ptr> Hotels;
-	/// Smart pointer to passenger information for flight reservations.
-	PassengerInfo_ptr passenger_info;
-	/// Smart pointer to customer information for hotel reservations.
-	CustomerInfo_ptr customer_info;
-	/// Smart pointer to the chosen flight information.
+	/// Passenger request of the current flight search, shared with its adapters.
+	PassengerQuery passenger_info;
+	/// Customer request of the current room search, shared with its adapters.
+	CustomerQuery customer_info;
+	/// Chosen flight information, allocated once and overwritten by every search.
 	FlightInfo_ptr chosen_flight;
-	/// Smart pointer to the chosen room information.
+	/// Chosen room information, allocated once and overwritten by every search.
 	RoomInfo_ptr chosen_room;
+	/// Worker pool running provider searches (declared after the adapters it uses).
+	WorkerPool_ptr search_pool;
+	/// Parallel search stage over the flight adapters.
+	SearchFanOut<FlightReservation, FoundFlightInfo> flight_search;
+	/// Parallel search stage over the hotel adapters.
+	SearchFanOut<HotelReservation, FoundRoomInfo> room_search;
+	/// Key flight results are ranked by.
+	FlightRanking flight_ranking { FlightRanking::PRICE };
+	/// Key room results are ranked by.
+	RoomRanking room_ranking { RoomRanking::PRICE_PER_NIGHT };
+	/// Connection search over every airline's inventory, built on first use.
+	ConnectionSearch_ptr connections;
+	/// Arena the result lists of a search are allocated from; rewound at the start of
+	/// every search.
+	SessionArena &arena;
 
 	/**
-	 * @brief Creates a reservation based on the specified brand.
-	 * @param brand The brand name for the reservation (e.g., hotel or airline brand).
-	 * @return A smart pointer to a Reservation object.
+	 * @brief Creates a reservation for the specified provider.
+	 * @param provider The ID of the brand offering the chosen flight or room.
+	 * @return A smart pointer to a Reservation object, or nullptr for an unknown provider.
 	 */
-	Reservation_ptr ReservationFactory(std::string &brand);
+	Reservation_ptr ReservationFactory(ProviderId provider);
 
 public:
 	/**
-	 * @brief Default constructor for MakeReservation.
+	 * @brief Constructor for MakeReservation.
+	 * @param arena Arena of the builder's session; it must outlive this object.
 	 */
-	MakeReservation();
+	explicit MakeReservation(SessionArena &arena);
 
 	/**
 	 * @brief Creates a flight reservation.
@@ -58,6 +83,27 @@ public:
 	 * @return A smart pointer to a Reservation object representing the hotel reservation.
 	 */
 	Reservation_ptr reservingRoom();
+
+	/**
+	 * @brief Creates a flight reservation with connections, possibly across airlines.
+	 * @return A smart pointer to an Itinerary holding one flight reservation per leg,
+	 *         or nullptr if nothing was chosen.
+	 */
+	Reservation_ptr reservingConnection();
+
+	/**
+	 * @brief Sets the key flight results are ranked by (price by default).
+	 * @details reservingFlight() asks for it with every search.
+	 * @param key The ranking key.
+	 */
+	void setFlightRanking(FlightRanking key);
+
+	/**
+	 * @brief Sets the key room results are ranked by (price per night by default).
+	 * @details reservingRoom() asks for it with every search.
+	 * @param key The ranking key.
+	 */
+	void setRoomRanking(RoomRanking key);
 };
 
 /**
@@ -0,0 +1,310 @@
+/**
+ * @file Mapped_Inventory.hpp
+ * @brief Binary provider inventory served straight from a memory mapping
+ * @details Provides:
+ *          - InventoryRecord: Fixed-size offer record of an inventory file
+ *          - MappedInventory: Read-only view of a mapped inventory file
+ *          - InventoryFileWriter: Builds inventory files (used by the converter)
+ *          - ProviderInventory: A provider's inventory, mapped or parsed from text
+ *
+ *          An inventory file ("<name>.inv") is a header, a bucket table sorted by
+ *          normalized key, the offer records grouped by bucket, and a string table. Opening
+ *          one costs a single mmap whatever its size; pages are read in as searches touch
+ *          them and are shared by every process serving the same file.
+ *
+ * @author Abdallah Salem
+ */
+#ifndef HEADERS_MAPPED_INVENTORY_HPP_
+#define HEADERS_MAPPED_INVENTORY_HPP_
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <utility>
+#include <functional>
+#include <unordered_map>
+#include <type_traits>
+#include "Inventory_Index.hpp"
+
+/**
+ * @class InventoryRecord
+ * @brief One offer of an inventory file.
+ * @details Flights keep minute numbers in from/to, rooms keep day numbers.
+ */
+class InventoryRecord {
+public:
+	std::uint32_t first;  ///< String table offset of the origin or country.
+	std::uint32_t second; ///< String table offset of the destination or city.
+	std::uint32_t label;  ///< String table offset of the room type (empty for flights).
+	std::int32_t count;   ///< Rooms available (0 for flights).
+	std::int32_t from;    ///< Departure minute or check-in day.
+	std::int32_t to;      ///< Arrival minute or check-out day.
+	std::int64_t price;   ///< Price, or price per night, in cents of the default currency.
+};
+
+static_assert(std::is_trivially_copyable<InventoryRecord>::value
+		&& sizeof(InventoryRecord) == 32, "inventory records are read in place");
+
+/**
+ * @class InventoryBucket
+ * @brief Offers filed under one normalized key of an inventory file.
+ */
+class InventoryBucket {
+public:
+	std::uint32_t key;     ///< String table offset of the normalized key.
+	std::uint32_t first;   ///< Index of the bucket's first record.
+	std::uint32_t records; ///< Number of records in the bucket.
+	std::uint32_t reserved; ///< Keeps the table 8-byte aligned.
+};
+
+/**
+ * @class InventoryFileHeader
+ * @brief Leading block of an inventory file.
+ */
+class InventoryFileHeader {
+public:
+	char magic[8];         ///< "EXPINV2" and a NUL.
+	std::uint32_t buckets; ///< Entries in the bucket table.
+	std::uint32_t records; ///< Entries in the record table.
+	std::uint32_t strings; ///< Bytes in the string table.
+	std::uint32_t reserved; ///< Keeps the tables 8-byte aligned.
+};
+
+/**
+ * @class MappedInventory
+ * @brief Read-only view of an inventory file mapped into memory.
+ * @details A file that is missing or fails validation leaves the view closed and empty.
+ *          Records are read in place; nothing is copied when the file is opened.
+ */
+class MappedInventory {
+private:
+	/// Start of the mapping.
+	const char *data { };
+	/// Length of the mapping in bytes.
+	std::size_t length { };
+	/// File contents on platforms without mmap.
+	std::vector<char> copy;
+	/// Bucket table, sorted by key.
+	const InventoryBucket *buckets { };
+	/// Record table.
+	const InventoryRecord *records { };
+	/// String table.
+	const char *strings { };
+	/// Header counts, once validated.
+	InventoryFileHeader header { };
+
+	/**
+	 * @brief Checks the header and every offset against the file length.
+	 * @return False if the file is not a well-formed inventory file.
+	 */
+	bool validate();
+
+	/**
+	 * @brief Releases the mapping.
+	 */
+	void close();
+
+public:
+	/**
+	 * @brief Creates a closed view.
+	 */
+	MappedInventory() = default;
+
+	/**
+	 * @brief Maps an inventory file.
+	 * @param path Path of the file.
+	 */
+	explicit MappedInventory(const std::string &path);
+
+	MappedInventory(const MappedInventory&) = delete;
+	MappedInventory& operator=(const MappedInventory&) = delete;
+
+	/**
+	 * @brief Unmaps the file.
+	 */
+	~MappedInventory();
+
+	/**
+	 * @brief Checks whether a valid file is mapped.
+	 * @return True if the file was mapped.
+	 */
+	bool isOpen() const {
+		return data != nullptr;
+	}
+
+	/**
+	 * @brief Gets the number of offers.
+	 * @return Records in the file, 0 when closed.
+	 */
+	std::size_t size() const {
+		return header.records;
+	}
+
+	/**
+	 * @brief Gets the offers filed under a key.
+	 * @details Binary search over the bucket table; the key is normalized like the
+	 *          InventoryIndex keys.
+	 * @param first Origin or country.
+	 * @param second Destination or city.
+	 * @return Begin and end of the matching records, equal if none.
+	 */
+	std::pair<const InventoryRecord*, const InventoryRecord*> find(
+			const std::string &first, const std::string &second) const;
+
+	/**
+	 * @brief Gets a string of the string table.
+	 * @param offset Offset stored in a record.
+	 * @return The NUL terminated string.
+	 */
+	const char* text(std::uint32_t offset) const {
+		return strings + offset;
+	}
+
+	/**
+	 * @brief Visits every record.
+	 * @param visit Called with each record.
+	 */
+	void forEach(const std::function<void(const InventoryRecord&)> &visit) const;
+};
+
+/**
+ * @class InventoryFileWriter
+ * @brief Collects offers and writes them as an inventory file.
+ */
+class InventoryFileWriter {
+private:
+	/// Records with the normalized key they are filed under.
+	std::vector<std::pair<std::string, InventoryRecord>> rows;
+	/// String table being built.
+	std::string strings;
+	/// Offsets of the strings already in the table.
+	std::unordered_map<std::string, std::uint32_t> interned;
+
+	/**
+	 * @brief Adds a string to the table once.
+	 * @return Its offset.
+	 */
+	std::uint32_t intern(const std::string &text);
+
+public:
+	/**
+	 * @brief Creates an empty writer.
+	 */
+	InventoryFileWriter();
+
+	/**
+	 * @brief Adds an offer.
+	 * @param first Origin or country.
+	 * @param second Destination or city.
+	 * @param label Room type, empty for flights.
+	 * @param count Rooms available, 0 for flights.
+	 * @param from Departure minute or check-in day.
+	 * @param to Arrival minute or check-out day.
+	 * @param price Price, or price per night, in the default currency.
+	 */
+	void add(const std::string &first, const std::string &second,
+			const std::string &label, int count, std::int32_t from, std::int32_t to,
+			const Money &price);
+
+	/**
+	 * @brief Gets the number of offers added.
+	 * @return Offers so far.
+	 */
+	std::size_t size() const {
+		return rows.size();
+	}
+
+	/**
+	 * @brief Writes the inventory file.
+	 * @param path Path of the file, replaced if present.
+	 * @return False if the file could not be written.
+	 */
+	bool write(const std::string &path) const;
+};
+
+/**
+ * @class ProviderInventory
+ * @brief Local inventory of one provider, from its mapped file or its text file.
+ * @details Adapters search it the same way whichever file it came from. A mapped
+ *          inventory decodes only the records a search returns.
+ * @tparam Offer The provider's own offer type (e.g. AirCanadaFlight, HiltonRoom).
+ */
+template<typename Offer>
+class ProviderInventory {
+public:
+	/// Turns a mapped record into the provider's offer.
+	typedef std::function<Offer(const MappedInventory&, const InventoryRecord&)> Decoder;
+
+private:
+	/// The mapped file, if the provider has one.
+	std::unique_ptr<MappedInventory> mapped;
+	/// Offers parsed from the text file otherwise.
+	InventoryIndex<Offer> index;
+	/// Decoder of mapped records.
+	Decoder decode;
+
+public:
+	/**
+	 * @brief Serves a mapped inventory file.
+	 * @param mapped The open file.
+	 * @param decode Decoder of its records.
+	 */
+	ProviderInventory(std::unique_ptr<MappedInventory> mapped, Decoder decode) :
+			mapped(std::move(mapped)), decode(std::move(decode)) {
+	}
+
+	/**
+	 * @brief Serves offers parsed from a text file.
+	 * @param index The parsed offers.
+	 */
+	explicit ProviderInventory(InventoryIndex<Offer> index) :
+			index(std::move(index)) {
+	}
+
+	/**
+	 * @brief Gets the offers filed under a key.
+	 * @param first Origin or country.
+	 * @param second Destination or city.
+	 * @return The matching offers, empty if none.
+	 */
+	std::vector<Offer> find(const std::string &first,
+			const std::string &second) const {
+		if (!mapped)
+			return index.find(first, second);
+		auto range = mapped->find(first, second);
+		std::vector<Offer> offers;
+		offers.reserve(range.second - range.first);
+		for (const InventoryRecord *record = range.first; record != range.second;
+				record++)
+			offers.push_back(decode(*mapped, *record));
+		return offers;
+	}
+
+	/**
+	 * @brief Visits every offer with the terms it is filed under.
+	 * @param visit Called with (first, second, offer) for each offer.
+	 */
+	void forEach(
+			const std::function<
+					void(const std::string&, const std::string&, const Offer&)> &visit) const {
+		if (!mapped) {
+			index.forEach(visit);
+			return;
+		}
+		mapped->forEach([&](const InventoryRecord &record) {
+			visit(mapped->text(record.first), mapped->text(record.second),
+					decode(*mapped, record));
+		});
+	}
+
+	/**
+	 * @brief Checks whether any offer was loaded.
+	 * @return True if the inventory is empty.
+	 */
+	bool empty() const {
+		return mapped ? mapped->size() == 0 : index.empty();
+	}
+};
+
+#endif /* HEADERS_MAPPED_INVENTORY_HPP_ */
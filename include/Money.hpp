@@ -0,0 +1,207 @@
+/**
+ * @file Money.hpp
+ * @brief Exact fixed-point amounts of money
+ * @details Provides:
+ *          - CurrencyCode: Three-letter ISO 4217 currency code
+ *          - CurrencyMismatch: Error raised when amounts of two currencies are combined
+ *          - Money: Amount counted in minor units (cents) with its currency
+ *
+ *          Amounts are integers, so sums are exact and do not depend on the order they are
+ *          added in.
+ *
+ * @author Abdallah Salem
+ */
+#ifndef HEADERS_MONEY_HPP_
+#define HEADERS_MONEY_HPP_
+
+#include <array>
+#include <string>
+#include <cstdint>
+#include <ostream>
+#include <stdexcept>
+
+/**
+ * @typedef CurrencyCode
+ * @brief Three-letter ISO 4217 code and a NUL (e.g. "USD").
+ */
+typedef std::array<char, 4> CurrencyCode;
+
+/**
+ * @class CurrencyMismatch
+ * @brief Thrown when amounts in different currencies are added, subtracted or compared.
+ */
+class CurrencyMismatch: public std::logic_error {
+public:
+	/**
+	 * @brief Constructs the error.
+	 * @param left Currency of the left amount.
+	 * @param right Currency of the right amount.
+	 */
+	CurrencyMismatch(const CurrencyCode &left, const CurrencyCode &right);
+};
+
+/**
+ * @class Money
+ * @brief Amount of money in minor units of its currency.
+ * @details Every price in the system is in the default currency unless a provider says
+ *          otherwise. A zero amount takes the currency of what is added to it, so totals can
+ *          start from Money().
+ */
+class Money {
+private:
+	/// Amount in minor units (cents).
+	std::int64_t minor_units { };
+	/// Currency of the amount.
+	CurrencyCode code;
+
+	/**
+	 * @brief Makes this amount's currency agree with another's.
+	 * @param other The other amount.
+	 * @throws CurrencyMismatch If both are non-zero and their currencies differ.
+	 */
+	void matchCurrency(const Money &other);
+
+public:
+	/// Minor units per major unit.
+	static const std::int64_t MINOR_PER_MAJOR = 100;
+
+	/**
+	 * @brief Gets the currency prices are in when none is given.
+	 * @return "USD".
+	 */
+	static CurrencyCode defaultCurrency();
+
+	/**
+	 * @brief Gets a currency code from its text.
+	 * @param code Three letters.
+	 * @return The code; only the first three characters are kept.
+	 */
+	static CurrencyCode currencyCode(const std::string &code);
+
+	/**
+	 * @brief Constructs zero in the default currency.
+	 */
+	Money();
+
+	/**
+	 * @brief Constructs an amount from minor units.
+	 * @param minor_units Amount in cents.
+	 * @param currency Its currency.
+	 */
+	explicit Money(std::int64_t minor_units, CurrencyCode currency =
+			defaultCurrency());
+
+	/**
+	 * @brief Converts an amount in major units, rounding to the nearest minor unit.
+	 * @param amount Amount in major units (e.g. 199.99).
+	 * @param currency Its currency.
+	 * @return The amount.
+	 */
+	static Money fromMajor(double amount, CurrencyCode currency =
+			defaultCurrency());
+
+	/**
+	 * @brief Parses a decimal amount such as "199.99" exactly.
+	 * @param text The amount, with at most two decimals.
+	 * @param money Receives the amount.
+	 * @param currency Its currency.
+	 * @return False if the text is not such an amount or does not fit in cents.
+	 */
+	static bool parse(const std::string &text, Money &money,
+			CurrencyCode currency = defaultCurrency());
+
+	/**
+	 * @brief Gets the amount in minor units.
+	 * @return Cents.
+	 */
+	std::int64_t minorUnits() const;
+
+	/**
+	 * @brief Gets the currency.
+	 * @return Its code.
+	 */
+	const CurrencyCode& currency() const;
+
+	/**
+	 * @brief Gets the currency as text.
+	 * @return Three letters.
+	 */
+	std::string currencyName() const;
+
+	/**
+	 * @brief Gets the amount in major units, for display only.
+	 * @return The amount as a double.
+	 */
+	double toMajor() const;
+
+	/**
+	 * @brief Checks whether the amount is zero.
+	 * @return True if it is zero.
+	 */
+	bool isZero() const;
+
+	/**
+	 * @brief Adds an amount.
+	 * @param other Amount in the same currency.
+	 * @return Reference to this amount.
+	 * @throws CurrencyMismatch If the currencies differ.
+	 */
+	Money& operator+=(const Money &other);
+
+	/**
+	 * @brief Subtracts an amount.
+	 * @param other Amount in the same currency.
+	 * @return Reference to this amount.
+	 * @throws CurrencyMismatch If the currencies differ.
+	 */
+	Money& operator-=(const Money &other);
+
+	/**
+	 * @brief Multiplies by a count (passengers, nights, rooms).
+	 * @param count The count.
+	 * @return Reference to this amount.
+	 */
+	Money& operator*=(std::int64_t count);
+
+	/**
+	 * @brief Compares amount and currency.
+	 */
+	bool operator==(const Money &other) const;
+
+	/**
+	 * @brief Orders amounts of one currency.
+	 * @throws CurrencyMismatch If the currencies differ and neither is zero.
+	 */
+	bool operator<(const Money &other) const;
+
+	/**
+	 * @brief Adds two amounts.
+	 */
+	friend Money operator+(Money left, const Money &right) {
+		return left += right;
+	}
+
+	/**
+	 * @brief Subtracts two amounts.
+	 */
+	friend Money operator-(Money left, const Money &right) {
+		return left -= right;
+	}
+
+	/**
+	 * @brief Multiplies an amount by a count.
+	 */
+	friend Money operator*(Money money, std::int64_t count) {
+		return money *= count;
+	}
+};
+
+/**
+ * @brief Writes an amount in major units, with two decimals only when it has cents.
+ * @param out Output stream to write to.
+ * @param money The amount.
+ * @return Reference to the output stream.
+ */
+std::ostream& operator<<(std::ostream &out, const Money &money);
+
+#endif /* HEADERS_MONEY_HPP_ */
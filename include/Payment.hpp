@@ -39,7 +39,7 @@ public:
 	 * @param money The amount to be paid.
 	 * @return True if the payment is successful, false otherwise.
 	 */
-	virtual bool makePayment(double money) = 0;
+	virtual bool makePayment(const Money &money) = 0;
 
 	/**
 	 * @brief Virtual destructor for IPayment.
@@ -13,6 +13,7 @@
 
 #include <iostream>
 #include <memory>
+#include "Money.hpp"
 
 /**
  * @class PayPalCreditCard
@@ -55,7 +56,7 @@ public:
 	 * @param money The amount to be paid.
 	 * @return True if the payment is successful, false otherwise.
 	 */
-	bool makePayment(double money);
+	bool makePayment(const Money &money);
 };
 
 /**
@@ -103,7 +104,7 @@ public:
 	 * @return True if the payment is successful, false otherwise.
 	 */
 	static bool WithDrawMoney(std::unique_ptr<StripeUserInfo> &user,
-			std::unique_ptr<StripeCardInfo> &card, double money);
+			std::unique_ptr<StripeCardInfo> &card, const Money &money);
 };
 
 /**
@@ -65,9 +65,10 @@ public:
 
 	/**
 	 * @brief Executes the payment transaction.
+	 * @param amount The amount to charge.
 	 * @return True if the payment is successful, false otherwise.
 	 */
-	bool makeThePayment();
+	bool makeThePayment(const Money &amount);
 };
 
 /**
@@ -63,7 +63,7 @@ public:
 	 * @param money The amount to be paid.
 	 * @return True if the payment is successful, false otherwise.
 	 */
-	bool makePayment(double money) override;
+	bool makePayment(const Money &money) override;
 };
 
 /**
@@ -115,7 +115,7 @@ public:
 	 * @param money The amount to be paid.
 	 * @return True if the payment is successful, false otherwise.
 	 */
-	bool makePayment(double money) override;
+	bool makePayment(const Money &money) override;
 };
 
 /**
@@ -151,7 +151,7 @@ public:
 	 * @param money The amount to be paid.
 	 * @return True if the payment is successful, false otherwise.
 	 */
-	bool makePayment(double money) override;
+	bool makePayment(const Money &money) override;
 };
 
 #endif /* HEADERS_PAYMENT_METHODS_HPP_ */
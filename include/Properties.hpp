@@ -12,6 +12,7 @@
 #define HEADERS_PROPERTIES_HPP_
 
 #include <iostream>
+#include "Money.hpp"
 
 /**
  * @class Printable
@@ -42,9 +43,9 @@ class Priced {
 public:
 	/**
 	 * @brief Retrieves the cost of the object.
-	 * @return The cost as a double.
+	 * @return The exact cost.
 	 */
-	virtual double getCost() const = 0;
+	virtual Money getCost() const = 0;
 
 	/**
 	 * @brief Virtual destructor for Priced.
@@ -0,0 +1,339 @@
+/**
+ * @file Provider_Limiter.hpp
+ * @brief Adaptive concurrency limits and circuit breakers for provider calls
+ * @details Provides:
+ *          - BreakerState: Whether a provider is called, shed or probed
+ *          - LimiterStats: Snapshot of a limiter's limit, queue and breaker
+ *          - LimiterSettings: Tuning of a limiter
+ *          - ProviderLimiter: Bounds the calls in flight to one provider, adapting the bound
+ *            to the latency it observes, and stops calling a provider that keeps failing
+ *
+ * @author Abdallah Salem
+ */
+#ifndef HEADERS_PROVIDER_LIMITER_HPP_
+#define HEADERS_PROVIDER_LIMITER_HPP_
+
+#include <mutex>
+#include <deque>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <ostream>
+#include <optional>
+#include <coroutine>
+#include <exception>
+#include <functional>
+#include <condition_variable>
+#include "Async_Call.hpp"
+
+/**
+ * @enum BreakerState
+ * @brief State of a provider's circuit breaker.
+ */
+enum class BreakerState {
+	/// Calls go through.
+	CLOSED,
+	/// Calls fail fast until the open time has passed.
+	OPEN,
+	/// One probe call is let through to see whether the provider recovered.
+	HALF_OPEN
+};
+
+/**
+ * @class LimiterStats
+ * @brief Snapshot of a limiter.
+ */
+class LimiterStats {
+public:
+	/// Provider name.
+	std::string provider;
+	/// Calls allowed in flight at once.
+	std::size_t limit { };
+	/// Calls in flight.
+	std::size_t in_flight { };
+	/// Callers waiting for a slot.
+	std::size_t queued { };
+	/// Breaker state.
+	BreakerState state { BreakerState::CLOSED };
+	/// Calls let through.
+	std::uint64_t admitted { };
+	/// Calls refused by the breaker or after waiting too long.
+	std::uint64_t rejected { };
+	/// Calls that failed.
+	std::uint64_t failures { };
+	/// Times the breaker opened.
+	std::uint64_t trips { };
+};
+
+/**
+ * @brief Writes a limiter snapshot as one line.
+ * @param out Output stream to write to.
+ * @param stats The snapshot.
+ * @return Reference to the output stream.
+ */
+std::ostream& operator<<(std::ostream &out, const LimiterStats &stats);
+
+/**
+ * @class LimiterSettings
+ * @brief Tuning of a provider limiter.
+ */
+class LimiterSettings {
+public:
+	double initial_limit { 16 };     ///< Calls allowed in flight at start.
+	double min_limit { 1 };          ///< Lowest the limit backs off to.
+	double max_limit { 256 };        ///< Highest the limit grows to.
+	double latency_tolerance { 2 };  ///< Calls slower than this many times the baseline back off.
+	double backoff { 0.9 };          ///< Factor applied to the limit on a slow or failed call.
+	int failure_threshold { 5 };     ///< Consecutive failures that open the breaker.
+	std::chrono::milliseconds open_time { 2000 };     ///< How long an open breaker sheds calls.
+	std::chrono::milliseconds queue_timeout { 1000 }; ///< Longest wait for a slot.
+};
+
+/**
+ * @class ProviderLimiter
+ * @brief Adaptive in-flight limit and circuit breaker of one provider.
+ * @details The limit follows AIMD against the provider's latency: while the recent
+ *          average latency stays within latency_tolerance of the long-run baseline, each
+ *          success raises the limit by 1/limit; once it climbs past it, or a call fails, the
+ *          limit is multiplied by backoff. Callers over the limit wait up to queue_timeout
+ *          for a slot.
+ *
+ *          After failure_threshold consecutive failures the breaker opens and every call is
+ *          refused at once for open_time; then one probe is let through, closing the breaker
+ *          if it succeeds and reopening it if not. A refused call gets the caller's fallback
+ *          (a cached or empty answer, or false).
+ *
+ *          Coroutines waiting for a slot are parked on the limiter and resumed on their loop
+ *          when a call releases one, or refused once queue_timeout has passed.
+ */
+class ProviderLimiter {
+public:
+	/**
+	 * @enum Admission
+	 * @brief Outcome of asking for a slot.
+	 */
+	enum class Admission {
+		ADMITTED, ///< A slot was taken.
+		FULL,     ///< Every slot is taken; the caller may wait.
+		REFUSED   ///< The breaker is open.
+	};
+
+private:
+	/**
+	 * @class SlotWaiter
+	 * @brief A coroutine parked until a slot frees up or its wait times out.
+	 */
+	class SlotWaiter {
+	public:
+		/// Loop to resume it on.
+		EventLoop *loop { };
+		/// The parked coroutine.
+		std::coroutine_handle<> waiting;
+		/// Outcome handed to it.
+		Admission admission { Admission::FULL };
+		/// Set once it has been handed an outcome, by a release or by its timeout.
+		bool woken { };
+	};
+
+	/**
+	 * @class SlotWait
+	 * @brief Awaitable taking a slot, parking the awaiting coroutine while none is free.
+	 */
+	class SlotWait {
+	public:
+		/// The limiter asked.
+		ProviderLimiter &limiter;
+		/// Loop to resume on.
+		EventLoop &loop;
+		/// When the wait gives up.
+		std::chrono::steady_clock::time_point deadline;
+		/// Outcome when no wait was needed.
+		Admission admission { Admission::FULL };
+		/// The parked waiter, when a wait was needed.
+		std::shared_ptr<SlotWaiter> waiter;
+
+		bool await_ready() const noexcept {
+			return false;
+		}
+
+		bool await_suspend(std::coroutine_handle<> awaiting);
+
+		Admission await_resume() const noexcept {
+			return waiter ? waiter->admission : admission;
+		}
+	};
+
+	/// Provider name.
+	std::string provider;
+	/// Tuning.
+	LimiterSettings settings;
+	/// Current limit; fractional so additive increase can be spread over many calls.
+	double limit;
+	/// Long-run average latency in microseconds, 0 until the first success.
+	double baseline { };
+	/// Average latency of the last few calls in microseconds.
+	double recent { };
+	/// Consecutive failed calls.
+	int consecutive_failures { };
+	/// When the breaker last opened.
+	std::chrono::steady_clock::time_point opened_at;
+	/// Counters and current state reported by stats().
+	LimiterStats counters;
+	/// Guards every member.
+	mutable std::mutex lock;
+	/// Signalled when a slot frees up or the breaker opens.
+	std::condition_variable room;
+	/// Coroutines waiting for a slot, oldest first.
+	std::deque<std::shared_ptr<SlotWaiter>> waiters;
+
+	/**
+	 * @brief Takes a slot if the breaker and the limit allow; lock must be held.
+	 */
+	Admission admit();
+
+	/**
+	 * @brief Hands slots, or the breaker's refusal, to parked coroutines; lock must be held.
+	 * @param woken Receives the waiters to resume once the lock is released.
+	 */
+	void wakeWaiters(std::vector<std::shared_ptr<SlotWaiter>> &woken);
+
+	/**
+	 * @brief Refuses a parked coroutine that is still waiting at its deadline.
+	 * @param loop The loop the timer runs on.
+	 * @param deadline When the wait gives up.
+	 * @param waiter The waiter.
+	 */
+	Detached expireWaiter(EventLoop &loop,
+			std::chrono::steady_clock::time_point deadline,
+			std::shared_ptr<SlotWaiter> waiter);
+
+public:
+	/**
+	 * @brief Creates a limiter.
+	 * @param provider Provider name, used in the stats.
+	 * @param settings Tuning.
+	 */
+	explicit ProviderLimiter(const std::string &provider,
+			const LimiterSettings &settings = LimiterSettings());
+
+	/**
+	 * @brief Gets the process-wide limiter of a provider, creating it on first use.
+	 * @param provider Provider name.
+	 * @return Reference to its limiter.
+	 */
+	static ProviderLimiter& forProvider(const std::string &provider);
+
+	/**
+	 * @brief Gets a snapshot of every process-wide limiter.
+	 * @return One snapshot per provider, in creation order.
+	 */
+	static std::vector<LimiterStats> allStats();
+
+	/**
+	 * @brief Waits for a slot.
+	 * @return True if a slot was taken; release() must follow.
+	 */
+	bool acquire();
+
+	/**
+	 * @brief Waits for a slot without holding a thread.
+	 * @details The wait's timer runs until queue_timeout, so the limiter must live that long.
+	 * @param loop The loop to wait on and be resumed on.
+	 * @return True if a slot was taken; release() must follow.
+	 */
+	Task<bool> acquireAsync(EventLoop &loop);
+
+	/**
+	 * @brief Returns a slot and feeds the call's outcome to the limit and the breaker.
+	 * @param latency How long the call took.
+	 * @param succeeded False if the call failed or timed out.
+	 */
+	void release(std::chrono::microseconds latency, bool succeeded);
+
+	/**
+	 * @brief Gets a snapshot of the limiter.
+	 * @return Limit, queue depth, breaker state and counters.
+	 */
+	LimiterStats stats() const;
+
+	/**
+	 * @brief Runs a provider call within the limit.
+	 * @param request The call; a thrown exception or a false result counts as a failure.
+	 * @param refused Answer used when no slot is given.
+	 * @return The call's result, or the fallback.
+	 * @throws The request's exception.
+	 */
+	template<typename Result>
+	Result call(const std::function<Result()> &request,
+			const std::function<Result()> &refused) {
+		if (!acquire())
+			return refused();
+		auto start = std::chrono::steady_clock::now();
+		try {
+			Result result = request();
+			release(elapsedSince(start), succeeded(result));
+			return result;
+		} catch (...) {
+			release(elapsedSince(start), false);
+			throw;
+		}
+	}
+
+	/**
+	 * @brief Awaits a provider call within the limit.
+	 * @param loop The loop to wait on.
+	 * @param request Starts the call; a thrown exception or a false result counts as a failure.
+	 * @param refused Answer used when no slot is given.
+	 * @return The call's result, or the fallback.
+	 * @throws The request's exception.
+	 */
+	template<typename Result>
+	Task<Result> callAsync(EventLoop &loop,
+			std::function<Task<Result>()> request,
+			std::function<Result()> refused) {
+		bool admitted = co_await acquireAsync(loop);
+		if (!admitted)
+			co_return refused();
+		auto start = std::chrono::steady_clock::now();
+		std::exception_ptr error;
+		std::optional<Result> result;
+		try {
+			result.emplace(co_await request());
+		} catch (...) {
+			error = std::current_exception();
+		}
+		release(elapsedSince(start), !error && succeeded(*result));
+		if (error)
+			std::rethrow_exception(error);
+		co_return std::move(*result);
+	}
+
+private:
+	/**
+	 * @brief Gets the time passed since a start point.
+	 */
+	static std::chrono::microseconds elapsedSince(
+			std::chrono::steady_clock::time_point start) {
+		return std::chrono::duration_cast<std::chrono::microseconds>(
+				std::chrono::steady_clock::now() - start);
+	}
+
+	/**
+	 * @brief A false answer from a reservation or payment call is a failure.
+	 */
+	static bool succeeded(bool result) {
+		return result;
+	}
+
+	/**
+	 * @brief Any answer from a search is a success; failures are thrown.
+	 */
+	template<typename Result>
+	static bool succeeded(const Result&) {
+		return true;
+	}
+};
+
+#endif /* HEADERS_PROVIDER_LIMITER_HPP_ */
@@ -0,0 +1,303 @@
+/**
+ * @file Provider_Metrics.hpp
+ * @brief Latency and outcome accounting of provider calls
+ * @details Provides:
+ *          - ValueHistogram: Log-linear histogram of latencies or result sizes
+ *          - CallOutcome: How a provider call ended
+ *          - CallStats: Snapshot of one provider operation
+ *          - CallMetrics: Records every call of one provider operation
+ *          - BookingCallMetrics: The search, reserve and cancel metrics of a travel provider
+ *
+ *          Each thread records into its own counters, so recording takes no lock and
+ *          shares no cache line with other threads; snapshots add up the threads' counters.
+ *          When a thread exits its counters are folded into a retired total and freed, so
+ *          memory follows the threads alive rather than every thread that ever ran.
+ *          When EXPEDIA_CALL_METRICS names a file, every operation's snapshot is written to
+ *          it when the program exits, followed by every provider limiter's limit, queue depth
+ *          and breaker state.
+ *
+ * @author Abdallah Salem
+ */
+#ifndef HEADERS_PROVIDER_METRICS_HPP_
+#define HEADERS_PROVIDER_METRICS_HPP_
+
+#include <array>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <ostream>
+#include <optional>
+#include <exception>
+#include <functional>
+#include "Async_Call.hpp"
+#include "Provider_Simulator.hpp"
+#include "Provider_Limiter.hpp"
+
+/**
+ * @class ValueHistogram
+ * @brief Histogram with buckets about 6% wide at any magnitude.
+ * @details Values below 16 get a bucket each; above that every power of two is split
+ *          into 16 buckets, as in an HDR histogram with one significant digit. Values up to
+ *          2^40 are told apart; larger ones share the last bucket.
+ */
+class ValueHistogram {
+public:
+	/// Number of buckets.
+	static const std::size_t BUCKETS = 16 + 36 * 16;
+
+	/// Values counted per bucket.
+	std::array<std::uint64_t, BUCKETS> counts { };
+
+	/**
+	 * @brief Gets the bucket a value falls in.
+	 * @param value The value.
+	 * @return Bucket index.
+	 */
+	static std::size_t bucketOf(std::uint64_t value);
+
+	/**
+	 * @brief Gets the largest value of a bucket.
+	 * @param bucket Bucket index.
+	 * @return Upper bound of the bucket.
+	 */
+	static std::uint64_t bucketLimit(std::size_t bucket);
+
+	/**
+	 * @brief Gets the number of values counted.
+	 * @return Sum of all buckets.
+	 */
+	std::uint64_t count() const;
+
+	/**
+	 * @brief Gets a percentile of the counted values.
+	 * @param fraction The percentile as a fraction (0.99 for p99).
+	 * @return Upper bound of the bucket holding it, 0 if nothing was counted.
+	 */
+	std::uint64_t percentile(double fraction) const;
+};
+
+/**
+ * @enum CallOutcome
+ * @brief How a provider call ended.
+ */
+enum class CallOutcome {
+	SUCCEEDED, ///< The provider answered.
+	FAILED,    ///< The provider returned an error or refused.
+	TIMED_OUT  ///< The provider did not answer in time.
+};
+
+/**
+ * @class CallStats
+ * @brief Snapshot of one provider operation, added up over every thread.
+ */
+class CallStats {
+public:
+	/// Provider name.
+	std::string provider;
+	/// Operation name ("search", "reserve", "cancel", "payment").
+	std::string operation;
+	/// Calls made.
+	std::uint64_t calls { };
+	/// Calls that failed.
+	std::uint64_t failures { };
+	/// Calls that timed out.
+	std::uint64_t timeouts { };
+	/// Latencies in microseconds.
+	ValueHistogram latency;
+	/// Offers returned by successful searches.
+	ValueHistogram results;
+	/// False if the operation was created past the measured limit and is not counted.
+	bool recorded { true };
+};
+
+/**
+ * @brief Writes a snapshot as one line with the main percentiles.
+ * @param out Output stream to write to.
+ * @param stats The snapshot.
+ * @return Reference to the output stream.
+ */
+std::ostream& operator<<(std::ostream &out, const CallStats &stats);
+
+/**
+ * @class CallMetrics
+ * @brief Counters of one operation of one provider.
+ * @details Reached through forCall(); adapters keep the reference rather than looking it
+ *          up on every call.
+ */
+class CallMetrics {
+private:
+	/// Slot of the operation in every thread's counters.
+	std::size_t id;
+	/// Provider name.
+	std::string provider;
+	/// Operation name.
+	std::string operation;
+
+public:
+	/// Slot of operations created past the measured limit; they are not recorded.
+	static const std::size_t UNRECORDED;
+
+	/**
+	 * @brief Creates the metrics of an operation; use forCall().
+	 * @param id Slot in the threads' counters, or UNRECORDED.
+	 * @param provider Provider name.
+	 * @param operation Operation name.
+	 */
+	CallMetrics(std::size_t id, const std::string &provider,
+			const std::string &operation);
+
+	/**
+	 * @brief Gets the process-wide metrics of an operation, creating them on first use.
+	 * @details Past the measured limit the operation is reported as not recorded rather
+	 *          than counted with another one.
+	 * @param provider Provider name.
+	 * @param operation Operation name.
+	 * @return Reference to its metrics.
+	 */
+	static CallMetrics& forCall(const std::string &provider,
+			const std::string &operation);
+
+	/**
+	 * @brief Gets a snapshot of every operation.
+	 * @return One snapshot per operation, in creation order.
+	 */
+	static std::vector<CallStats> allStats();
+
+	/**
+	 * @brief Writes every operation's snapshot, one per line.
+	 * @param out Output stream to write to.
+	 */
+	static void dump(std::ostream &out);
+
+	/**
+	 * @brief Records one call in the calling thread's counters.
+	 * @param latency How long the call took.
+	 * @param outcome How it ended.
+	 * @param results Offers returned, if the call returns offers.
+	 */
+	void record(std::chrono::microseconds latency, CallOutcome outcome,
+			std::optional<std::size_t> results = std::nullopt);
+
+	/**
+	 * @brief Gets a snapshot of the operation.
+	 * @return Counters and histograms added up over every thread.
+	 */
+	CallStats stats() const;
+
+	/**
+	 * @brief Makes a provider call and records it.
+	 * @param request The call; a thrown exception or a false result counts as a failure,
+	 *                a ProviderTimeout as a timeout.
+	 * @return The call's result.
+	 * @throws The call's exception.
+	 */
+	template<typename Result>
+	Result measure(const std::function<Result()> &request) {
+		auto start = std::chrono::steady_clock::now();
+		try {
+			Result result = request();
+			record(elapsedSince(start), outcomeOf(result), resultCount(result));
+			return result;
+		} catch (const ProviderTimeout&) {
+			record(elapsedSince(start), CallOutcome::TIMED_OUT);
+			throw;
+		} catch (...) {
+			record(elapsedSince(start), CallOutcome::FAILED);
+			throw;
+		}
+	}
+
+	/**
+	 * @brief Awaits a provider call and records it.
+	 * @param request Starts the call; outcomes are counted as by measure().
+	 * @return The call's result.
+	 * @throws The call's exception.
+	 */
+	template<typename Result>
+	Task<Result> measureAsync(std::function<Task<Result>()> request) {
+		auto start = std::chrono::steady_clock::now();
+		std::exception_ptr error;
+		CallOutcome failure = CallOutcome::FAILED;
+		std::optional<Result> result;
+		try {
+			Task<Result> call = request();
+			result.emplace(co_await call);
+		} catch (const ProviderTimeout&) {
+			error = std::current_exception();
+			failure = CallOutcome::TIMED_OUT;
+		} catch (...) {
+			error = std::current_exception();
+		}
+		if (error) {
+			record(elapsedSince(start), failure);
+			std::rethrow_exception(error);
+		}
+		record(elapsedSince(start), outcomeOf(*result), resultCount(*result));
+		co_return std::move(*result);
+	}
+
+private:
+	/**
+	 * @brief Gets the time passed since a start point.
+	 */
+	static std::chrono::microseconds elapsedSince(
+			std::chrono::steady_clock::time_point start) {
+		return std::chrono::duration_cast<std::chrono::microseconds>(
+				std::chrono::steady_clock::now() - start);
+	}
+
+	/**
+	 * @brief A false answer from a reservation or payment call is a failure.
+	 */
+	static CallOutcome outcomeOf(bool result) {
+		return result ? CallOutcome::SUCCEEDED : CallOutcome::FAILED;
+	}
+
+	/**
+	 * @brief Any answer from a search is a success; failures are thrown.
+	 */
+	template<typename Result>
+	static CallOutcome outcomeOf(const Result&) {
+		return CallOutcome::SUCCEEDED;
+	}
+
+	/**
+	 * @brief Reservation and payment calls return no offers.
+	 */
+	static std::optional<std::size_t> resultCount(bool) {
+		return std::nullopt;
+	}
+
+	/**
+	 * @brief A search returns its offers.
+	 */
+	template<typename Offer>
+	static std::optional<std::size_t> resultCount(
+			const std::vector<Offer> &offers) {
+		return offers.size();
+	}
+};
+
+/**
+ * @class BookingCallMetrics
+ * @brief Metrics of the three calls every airline and hotel adapter makes.
+ */
+class BookingCallMetrics {
+public:
+	CallMetrics &search;  ///< Availability searches.
+	CallMetrics &reserve; ///< Reservations.
+	CallMetrics &cancel;  ///< Cancellations.
+
+	/**
+	 * @brief Gets the metrics of a provider's calls.
+	 * @param provider Provider name.
+	 */
+	explicit BookingCallMetrics(const std::string &provider) :
+			search(CallMetrics::forCall(provider, "search")), reserve(
+					CallMetrics::forCall(provider, "reserve")), cancel(
+					CallMetrics::forCall(provider, "cancel")) {
+	}
+};
+
+#endif /* HEADERS_PROVIDER_METRICS_HPP_ */
@@ -0,0 +1,84 @@
+/**
+ * @file Provider_Registry.hpp
+ * @brief Interning of provider brand names
+ * @details Provides:
+ *          - ProviderId: Small integer naming an airline or hotel chain
+ *          - ProviderRegistry: Assigns IDs to brand names and maps them back
+ *
+ * @author Abdallah Salem
+ */
+#ifndef HEADERS_PROVIDER_REGISTRY_HPP_
+#define HEADERS_PROVIDER_REGISTRY_HPP_
+
+#include <deque>
+#include <mutex>
+#include <string>
+#include <cstdint>
+#include <unordered_map>
+
+/**
+ * @typedef ProviderId
+ * @brief Interned identifier of a provider brand, dense from zero.
+ */
+typedef std::uint16_t ProviderId;
+
+/**
+ * @class ProviderRegistry
+ * @brief Process-wide table of provider brands.
+ * @details Each brand is interned once, when its adapter first asks for its ID, and is
+ *          then carried through search results as a ProviderId. The name is only looked
+ *          up again when a result is printed.
+ */
+class ProviderRegistry {
+private:
+	/// Brand names indexed by ID; a deque keeps returned references stable.
+	std::deque<std::string> names;
+	/// Reverse lookup from brand name to ID.
+	std::unordered_map<std::string, ProviderId> ids;
+	/// Guards both tables.
+	mutable std::mutex lock;
+
+	/**
+	 * @brief Private constructor, use instance().
+	 */
+	ProviderRegistry() = default;
+
+public:
+	/**
+	 * @brief Deleted copy constructor, the registry is a singleton.
+	 */
+	ProviderRegistry(const ProviderRegistry &other) = delete;
+
+	/**
+	 * @brief Deleted copy assignment operator.
+	 */
+	ProviderRegistry& operator=(const ProviderRegistry &other) = delete;
+
+	/**
+	 * @brief Gets the process-wide registry.
+	 * @return Reference to the registry.
+	 */
+	static ProviderRegistry& instance();
+
+	/**
+	 * @brief Returns the ID of a brand, assigning the next free one on first use.
+	 * @param name Brand name (e.g. "Canada", "Hilton").
+	 * @return The brand's ID.
+	 */
+	ProviderId intern(const std::string &name);
+
+	/**
+	 * @brief Gets the brand name of an ID.
+	 * @param id A previously interned ID.
+	 * @return The brand name, or an empty string for an unknown ID.
+	 */
+	const std::string& name(ProviderId id) const;
+
+	/**
+	 * @brief Gets the number of interned brands.
+	 * @return One past the largest assigned ID.
+	 */
+	std::size_t size() const;
+};
+
+#endif /* HEADERS_PROVIDER_REGISTRY_HPP_ */
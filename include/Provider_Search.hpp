@@ -0,0 +1,225 @@
+/**
+ * @file Provider_Search.hpp
+ * @brief Search pipeline in front of one provider's API
+ * @details Provides:
+ *          - ProviderSearch: Cache, local inventory, coalescing, hedging, limiting and
+ *            metrics around a provider's search call, blocking or on an EventLoop
+ *
+ * @author Abdallah Salem
+ */
+#ifndef HEADERS_PROVIDER_SEARCH_HPP_
+#define HEADERS_PROVIDER_SEARCH_HPP_
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+#include <utility>
+#include <optional>
+#include <functional>
+#include "Async_Call.hpp"
+#include "Search_Cache.hpp"
+#include "Single_Flight.hpp"
+#include "Hedged_Call.hpp"
+#include "Provider_Limiter.hpp"
+#include "Provider_Metrics.hpp"
+#include "Provider_Simulator.hpp"
+
+/**
+ * @class ProviderSearch
+ * @brief Answers the searches of one provider.
+ * @details A search is answered from the cache, else from the provider's local inventory
+ *          (unless the simulator is active), else from its API. API calls are shared by
+ *          identical concurrent searches, hedged past the provider's p95, admitted by its
+ *          limiter and measured; their answer is cached. When the provider is unavailable
+ *          the last cached answer is returned, even if expired.
+ * @tparam Offer One offer in the provider's format (e.g. AirCanadaFlight).
+ * @tparam Query Our own request (PassengerInfo or CustomerInfo).
+ * @tparam Request The request in the provider's format.
+ */
+template<typename Offer, typename Query, typename Request>
+class ProviderSearch {
+public:
+	/// The provider's answer.
+	typedef std::vector<Offer> Offers;
+
+	/**
+	 * @class Calls
+	 * @brief How the provider is searched.
+	 */
+	class Calls {
+	public:
+		/// Builds the cache key of a search.
+		std::function<std::string(const Query&)> key;
+		/// Puts a search in the provider's format, right before calling it.
+		std::function<Request(const Query&)> request;
+		/// Answers a search from local inventory; nullopt when there is none.
+		std::function<std::optional<Offers>(const Query&)> local;
+		/// The provider's search API, given its own copy of the request.
+		std::function<Offers(Request&)> api;
+		/// The provider's search API, awaited on a loop.
+		std::function<Task<Offers>(EventLoop&, const Request&)> api_async;
+	};
+
+private:
+	/// Provider name, for its limiter and errors.
+	std::string provider;
+	/// How the provider is searched.
+	Calls calls;
+	/// Answers by search key.
+	SearchCache<Offers> answers;
+	/// API calls in flight by search key.
+	SingleFlight<Offers> searches;
+	/// Hedges slow API calls.
+	Hedger hedger;
+	/// Admits the API calls.
+	ProviderLimiter &limiter;
+	/// Latency and outcome of the API calls.
+	CallMetrics &metrics;
+
+	/**
+	 * @brief Calls the API through the limiter and metrics.
+	 * @param request The request in the provider's format, a copy the API may change.
+	 * @return The provider's answer.
+	 * @throws ProviderUnavailable if the limiter sheds the call.
+	 */
+	Offers callApi(Request request) {
+		return limiter.call<Offers>([this, &request] {
+			return metrics.measure<Offers>([this, &request] {
+				return calls.api(request);
+			});
+		}, [this]() -> Offers {
+			throw ProviderUnavailable(provider);
+		});
+	}
+
+	/**
+	 * @brief Calls the API on the loop through the hedger, limiter and metrics, and
+	 *        caches its answer.
+	 * @param loop The loop the call waits on.
+	 * @param key Cache key of the search.
+	 * @param request The request in the provider's format.
+	 * @return The provider's answer.
+	 */
+	Task<Offers> callApiAsync(EventLoop &loop, std::string key, Request request) {
+		//a losing hedge may outlive this call, so every attempt keeps its own request.
+		Task<Offers> search = hedger.callAsync<Offers>(loop, [this, &loop, request] {
+			return limiter.callAsync<Offers>(loop, [this, &loop, request] {
+				return metrics.measureAsync<Offers>([this, &loop, request] {
+					return calls.api_async(loop, request);
+				});
+			}, [this]() -> Offers {
+				throw ProviderUnavailable(provider);
+			});
+		});
+		Offers offers = co_await search;
+		answers.put(key, offers);
+		co_return offers;
+	}
+
+	/**
+	 * @brief Answers a search from the cache or local inventory.
+	 * @param key Cache key of the search.
+	 * @param query The request.
+	 * @param offers Receives the answer.
+	 * @return False if the API has to be called.
+	 */
+	bool findLocally(const std::string &key, const Query &query, Offers &offers) {
+		if (answers.get(key, offers))
+			return true;
+		if (ProviderSimulator::instance().isActive())
+			return false;
+		std::optional<Offers> stocked = calls.local(query);
+		if (!stocked)
+			return false;
+		offers = std::move(*stocked);
+		answers.put(key, offers);
+		return true;
+	}
+
+public:
+	/**
+	 * @brief Creates the pipeline of a provider.
+	 * @param provider Provider name, as given to ProviderLimiter::forProvider().
+	 * @param metrics Where the API calls are measured.
+	 * @param capacity Cache capacity in searches.
+	 * @param ttl How long a cached answer is served.
+	 * @param calls How the provider is searched.
+	 */
+	ProviderSearch(const std::string &provider, CallMetrics &metrics,
+			std::size_t capacity, std::chrono::seconds ttl, Calls calls) :
+			provider(provider), calls(std::move(calls)), answers(capacity, ttl), limiter(
+					ProviderLimiter::forProvider(provider)), metrics(metrics) {
+	}
+
+	/**
+	 * @brief Answers a search, blocking on the API on a miss.
+	 * @param query The request.
+	 * @return The provider's answer.
+	 * @throws ProviderUnavailable if the provider failed and nothing was cached.
+	 */
+	Offers find(const Query &query) {
+		std::string key = calls.key(query);
+		Offers offers;
+		if (findLocally(key, query, offers))
+			return offers;
+		try {
+			offers = searches.run(key, [&] {
+				Offers fetched = hedger.call<Offers>(
+						[this, request = calls.request(query)] {
+							return callApi(request);
+						});
+				answers.put(key, fetched);
+				return fetched;
+			});
+		} catch (const ProviderUnavailable&) {
+			//fail fast with the last answer for this search, if there is one.
+			if (!answers.getStale(key, offers))
+				throw;
+		}
+		return offers;
+	}
+
+	/**
+	 * @brief Answers a search like find(), awaiting the API on the loop instead of
+	 *        blocking a thread.
+	 * @param loop The loop the call waits on.
+	 * @param query The request.
+	 * @return The provider's answer.
+	 */
+	Task<Offers> findAsync(EventLoop &loop, std::shared_ptr<const Query> query) {
+		std::string key = calls.key(*query);
+		Offers offers;
+		if (findLocally(key, *query, offers))
+			co_return offers;
+		try {
+			Task<Offers> search = searches.runAsync(loop, key,
+					[this, &loop, key, request = calls.request(*query)] {
+						return callApiAsync(loop, key, request);
+					});
+			offers = co_await search;
+		} catch (const ProviderUnavailable&) {
+			if (!answers.getStale(key, offers))
+				throw;
+		}
+		co_return offers;
+	}
+
+	/**
+	 * @brief Gets the answers cached so far.
+	 * @return The cache, e.g. to reconcile it with our own bookings.
+	 */
+	SearchCache<Offers>& cache() {
+		return answers;
+	}
+
+	/**
+	 * @brief Gets a snapshot of the cache and of the coalesced searches.
+	 * @return The provider's search counters.
+	 */
+	SearchStats stats() const {
+		return SearchStats { provider, answers.stats(), searches.coalesced() };
+	}
+};
+
+#endif /* HEADERS_PROVIDER_SEARCH_HPP_ */
@@ -0,0 +1,280 @@
+/**
+ * @file Provider_Simulator.hpp
+ * @brief Local stand-in for the airline, hotel and payment services
+ * @details Provides:
+ *          - SimulationProfile: Inventory size, latency, error rate and timeout of a provider
+ *          - ProviderUnavailable: Raised by a search that failed, timed out or was shed
+ *          - ProviderTimeout: Raised by a search that timed out
+ *          - SimulatedFlight / SimulatedRoom: Generated offers
+ *          - ProviderSimulator: Serves generated inventory with sampled latency and failures,
+ *            blocking or as coroutines that wait on an event loop timer
+ *
+ *          The simulator is off unless EXPEDIA_SIMULATOR names a profile file. When it is
+ *          on, every provider API stub answers through it instead of its fixed rows.
+ *
+ * @author Abdallah Salem
+ */
+#ifndef HEADERS_PROVIDER_SIMULATOR_HPP_
+#define HEADERS_PROVIDER_SIMULATOR_HPP_
+
+#include <mutex>
+#include <random>
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include <unordered_map>
+#include "Date.hpp"
+#include "Money.hpp"
+#include "Async_Call.hpp"
+
+/**
+ * @class SimulationProfile
+ * @brief Behaviour of one simulated provider.
+ * @details Latency follows a log-normal distribution fitted to the given median and 99th
+ *          percentile. A call slower than the timeout fails after waiting the timeout.
+ */
+class SimulationProfile {
+public:
+	std::size_t inventory { 20 }; ///< Offers returned per search.
+	double p50_ms { 50 };         ///< Median latency in milliseconds.
+	double p99_ms { 400 };        ///< 99th percentile latency in milliseconds.
+	double error_rate { };        ///< Probability that a call fails outright (0 - 1).
+	double timeout_ms { };        ///< Calls slower than this fail (0 for no timeout).
+};
+
+/**
+ * @class ProviderUnavailable
+ * @brief Raised by a simulated search that failed or timed out, or by a search the
+ *        provider's limiter shed.
+ * @details Searches have no other way to report a failure; the search fan-out catches it
+ *          and treats the provider as having found nothing.
+ */
+class ProviderUnavailable: public std::runtime_error {
+public:
+	/**
+	 * @brief Constructs the error.
+	 * @param provider Name of the failing provider.
+	 */
+	explicit ProviderUnavailable(const std::string &provider) :
+			std::runtime_error(provider + " is unavailable") {
+	}
+};
+
+/**
+ * @class ProviderTimeout
+ * @brief Raised by a simulated search that ran past the provider's timeout.
+ * @details A ProviderUnavailable, so callers that only care whether there is an answer
+ *          need not tell the two apart; call metrics count it as a timeout.
+ */
+class ProviderTimeout: public ProviderUnavailable {
+public:
+	/**
+	 * @brief Constructs the error.
+	 * @param provider Name of the provider that timed out.
+	 */
+	explicit ProviderTimeout(const std::string &provider) :
+			ProviderUnavailable(provider) {
+	}
+};
+
+/**
+ * @class SimulatedFlight
+ * @brief A generated flight offer.
+ */
+class SimulatedFlight {
+public:
+	Money price;        ///< Ticket price.
+	DateTime departure; ///< Departure date and time.
+	DateTime arrival;   ///< Arrival date and time.
+};
+
+/**
+ * @class SimulatedRoom
+ * @brief A generated room offer.
+ */
+class SimulatedRoom {
+public:
+	std::string room_type;    ///< Room type (e.g. "City View").
+	int available { };        ///< Rooms available.
+	Money price_per_night;    ///< Price per night.
+	Date from;                ///< Start of availability.
+	Date to;                  ///< End of availability.
+};
+
+/**
+ * @class ProviderSimulator
+ * @brief Process-wide simulated provider layer.
+ * @details Profiles are read from the file named by EXPEDIA_SIMULATOR. Each line is a
+ *          provider name ("Canada", "Turkish", "Hilton", "Marriott", "PayPal", "Stripe",
+ *          "Square") or "default", followed by key=value pairs among inventory, p50, p99,
+ *          errors and timeout. A provider without its own line uses the default profile.
+ *          Generated offers are the same for the same provider and request.
+ */
+class ProviderSimulator {
+private:
+	/// True when EXPEDIA_SIMULATOR is set.
+	bool active { };
+	/// Profile of providers without their own line.
+	SimulationProfile defaults;
+	/// Profiles by provider name.
+	std::unordered_map<std::string, SimulationProfile> profiles;
+	/// Source of latency and failure draws.
+	std::mt19937_64 random;
+	/// Guards the random source.
+	std::mutex random_lock;
+
+	/**
+	 * @brief Private constructor, use instance().
+	 */
+	ProviderSimulator();
+
+	/**
+	 * @brief Reads a profile file.
+	 * @param path Path of the file.
+	 */
+	void load(const std::string &path);
+
+	/**
+	 * @brief Draws a uniform number in [0, 1).
+	 */
+	double uniform();
+
+	/**
+	 * @brief Draws a standard normal number.
+	 */
+	double normal();
+
+	/**
+	 * @enum Answer
+	 * @brief Outcome of one simulated call.
+	 */
+	enum class Answer {
+		ANSWERED, ///< The call succeeded.
+		FAILED,   ///< The call returned an error.
+		TIMED_OUT ///< The call ran past the timeout.
+	};
+
+	/**
+	 * @brief Draws the latency and outcome of one call.
+	 * @param provider Provider name.
+	 * @param latency Receives how long the call takes.
+	 * @return The outcome.
+	 */
+	Answer draw(const std::string &provider, std::chrono::microseconds &latency);
+
+	/**
+	 * @brief Throws the error of a search that got no answer.
+	 * @throws ProviderTimeout or ProviderUnavailable unless the call was answered.
+	 */
+	static void checkAnswer(const std::string &provider, Answer answer);
+
+	/**
+	 * @brief Generates the flights of a search.
+	 */
+	std::vector<SimulatedFlight> generateFlights(const std::string &provider,
+			const std::string &from, const std::string &to, DateTime day) const;
+
+	/**
+	 * @brief Generates the rooms of a search.
+	 */
+	std::vector<SimulatedRoom> generateRooms(const std::string &provider,
+			const std::string &city, Date from, Date to) const;
+
+public:
+	/**
+	 * @brief Deleted copy constructor, the simulator is a singleton.
+	 */
+	ProviderSimulator(const ProviderSimulator &other) = delete;
+
+	/**
+	 * @brief Deleted copy assignment operator.
+	 */
+	ProviderSimulator& operator=(const ProviderSimulator &other) = delete;
+
+	/**
+	 * @brief Gets the process-wide simulator.
+	 * @return Reference to the simulator.
+	 */
+	static ProviderSimulator& instance();
+
+	/**
+	 * @brief Checks whether the provider APIs are switched to the simulator.
+	 * @return True if EXPEDIA_SIMULATOR is set.
+	 */
+	bool isActive() const;
+
+	/**
+	 * @brief Gets the profile of a provider.
+	 * @param provider Provider name.
+	 * @return Its own profile, or the default one.
+	 */
+	const SimulationProfile& profile(const std::string &provider) const;
+
+	/**
+	 * @brief Simulates one call: waits a sampled latency and draws a failure.
+	 * @param provider Provider name.
+	 * @return False if the call failed or timed out.
+	 */
+	bool call(const std::string &provider);
+
+	/**
+	 * @brief Simulates a flight search.
+	 * @param provider Provider name.
+	 * @param from Origin.
+	 * @param to Destination.
+	 * @param day Requested departure day.
+	 * @return Generated flights departing that day.
+	 * @throws ProviderUnavailable if the call failed, ProviderTimeout if it timed out.
+	 */
+	std::vector<SimulatedFlight> searchFlights(const std::string &provider,
+			const std::string &from, const std::string &to, DateTime day);
+
+	/**
+	 * @brief Simulates a room search.
+	 * @param provider Provider name.
+	 * @param city Requested city.
+	 * @param from Check-in date.
+	 * @param to Check-out date.
+	 * @return Generated rooms available over the stay.
+	 * @throws ProviderUnavailable if the call failed, ProviderTimeout if it timed out.
+	 */
+	std::vector<SimulatedRoom> searchRooms(const std::string &provider,
+			const std::string &city, Date from, Date to);
+
+	/**
+	 * @brief Simulates one call without holding a thread while it is in flight.
+	 * @param loop The loop to wait on.
+	 * @param provider Provider name.
+	 * @return False if the call failed or timed out.
+	 */
+	Task<bool> callAsync(EventLoop &loop, std::string provider);
+
+	/**
+	 * @brief Simulates a flight search without holding a thread while it is in flight.
+	 * @param loop The loop to wait on.
+	 * @param provider Provider name.
+	 * @param from Origin.
+	 * @param to Destination.
+	 * @param day Requested departure day.
+	 * @return Generated flights departing that day.
+	 * @throws ProviderUnavailable if the call failed, ProviderTimeout if it timed out.
+	 */
+	Task<std::vector<SimulatedFlight>> searchFlightsAsync(EventLoop &loop,
+			std::string provider, std::string from, std::string to,
+			DateTime day);
+
+	/**
+	 * @brief Simulates a room search without holding a thread while it is in flight.
+	 * @param loop The loop to wait on.
+	 * @param provider Provider name.
+	 * @param city Requested city.
+	 * @param from Check-in date.
+	 * @param to Check-out date.
+	 * @return Generated rooms available over the stay.
+	 * @throws ProviderUnavailable if the call failed, ProviderTimeout if it timed out.
+	 */
+	Task<std::vector<SimulatedRoom>> searchRoomsAsync(EventLoop &loop,
+			std::string provider, std::string city, Date from, Date to);
+};
+
+#endif /* HEADERS_PROVIDER_SIMULATOR_HPP_ */
@@ -0,0 +1,181 @@
+/**
+ * @file Ranked_Results.hpp
+ * @brief Page-by-page ranking of search results
+ * @details Provides:
+ *          - RankedResults: Ranks only as many results as the pages shown so far
+ *          - FlightRanking / RoomRanking: Keys the results can be ranked by
+ *          - Orderings implementing those keys
+ *
+ * @author Abdallah Salem
+ */
+#ifndef HEADERS_RANKED_RESULTS_HPP_
+#define HEADERS_RANKED_RESULTS_HPP_
+
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <functional>
+#include <memory_resource>
+#include "Flight_Reservation_Info.hpp"
+#include "Hotel_Reservation_Info.hpp"
+
+/**
+ * @class RankedResults
+ * @brief Search results ranked lazily, one page at a time.
+ * @details The results are kept in one vector whose front holds the pages already
+ *          shown, in final order; the tail is left unsorted. Fetching the next page
+ *          partially sorts the tail for just one page, so the first screen costs
+ *          O(n log k) instead of sorting everything, and later pages never redo
+ *          earlier work. The vector may draw from a session's arena.
+ * @tparam Info The result record type (FoundFlightInfo or FoundRoomInfo).
+ */
+template<typename Info>
+class RankedResults {
+public:
+	/**
+	 * @typedef Order
+	 * @brief Strict weak ordering, true if the first result ranks before the second.
+	 */
+	typedef std::function<bool(const Info&, const Info&)> Order;
+
+private:
+	/// Results; [0, ranked) is in final order, the rest is unsorted.
+	std::pmr::vector<Info> results;
+	/// Ranking applied to the results.
+	Order order;
+	/// Number of results per page.
+	std::size_t page_size;
+	/// Number of leading results already in final order.
+	std::size_t ranked { };
+
+public:
+	/**
+	 * @brief Takes ownership of a result set.
+	 * @param results The unsorted results; their allocator is kept.
+	 * @param order Ranking to apply.
+	 * @param page_size Number of results per page (at least one).
+	 * @param shown Number of leading results already shown, kept where they are.
+	 */
+	RankedResults(std::pmr::vector<Info> &&results, Order order, std::size_t page_size,
+			std::size_t shown = 0) :
+			results(std::move(results)), order(std::move(order)), page_size(
+					page_size ? page_size : 1), ranked(
+					std::min(shown, this->results.size())) {
+	}
+
+	/**
+	 * @brief Checks whether results remain beyond the pages already ranked.
+	 * @return True if nextPage() would return a non-empty page.
+	 */
+	bool hasNextPage() const {
+		return ranked < results.size();
+	}
+
+	/**
+	 * @brief Ranks the next page of results.
+	 * @return Index range [first, second) of the page within the results.
+	 */
+	std::pair<std::size_t, std::size_t> nextPage() {
+		std::size_t first = ranked;
+		std::size_t last = std::min(results.size(), ranked + page_size);
+		std::partial_sort(results.begin() + first, results.begin() + last,
+				results.end(), order);
+		ranked = last;
+		return {first, last};
+	}
+
+	/**
+	 * @brief Gets the number of results ranked so far.
+	 * @return Size of the ranked prefix.
+	 */
+	std::size_t rankedCount() const {
+		return ranked;
+	}
+
+	/**
+	 * @brief Accesses a result by position.
+	 * @param index Position within the results.
+	 * @return The result.
+	 */
+	const Info& operator[](std::size_t index) const {
+		return results[index];
+	}
+
+	/**
+	 * @brief Moves a result out of the set.
+	 * @param index Position within the results.
+	 * @return The result; the slot is left moved-from.
+	 */
+	Info take(std::size_t index) {
+		return std::move(results[index]);
+	}
+};
+
+/**
+ * @enum FlightRanking
+ * @brief Keys flight results can be ranked by.
+ */
+enum class FlightRanking {
+	PRICE,    ///< Cheapest ticket first.
+	DEPARTURE ///< Earliest departure first.
+};
+
+/**
+ * @enum RoomRanking
+ * @brief Keys room results can be ranked by.
+ */
+enum class RoomRanking {
+	PRICE_PER_NIGHT, ///< Cheapest night first.
+	CHECK_IN         ///< Earliest check-in first.
+};
+
+/**
+ * @brief Builds the ordering for a flight ranking key.
+ * @details Ties are broken by the other key and then by provider, so pages are the
+ *          same whichever provider answered first.
+ * @param key The ranking key.
+ * @return The ordering.
+ */
+inline RankedResults<FoundFlightInfo>::Order flightOrder(FlightRanking key) {
+	if (key == FlightRanking::DEPARTURE)
+		return [](const FoundFlightInfo &a, const FoundFlightInfo &b) {
+			if (a.from_date != b.from_date)
+				return a.from_date < b.from_date;
+			if (a.price != b.price)
+				return a.price < b.price;
+			return a.airline < b.airline;
+		};
+	return [](const FoundFlightInfo &a, const FoundFlightInfo &b) {
+		if (a.price != b.price)
+			return a.price < b.price;
+		if (a.from_date != b.from_date)
+			return a.from_date < b.from_date;
+		return a.airline < b.airline;
+	};
+}
+
+/**
+ * @brief Builds the ordering for a room ranking key.
+ * @details Ties are broken by the other key and then by hotel chain.
+ * @param key The ranking key.
+ * @return The ordering.
+ */
+inline RankedResults<FoundRoomInfo>::Order roomOrder(RoomRanking key) {
+	if (key == RoomRanking::CHECK_IN)
+		return [](const FoundRoomInfo &a, const FoundRoomInfo &b) {
+			if (a.from_date != b.from_date)
+				return a.from_date < b.from_date;
+			if (a.price_for_night != b.price_for_night)
+				return a.price_for_night < b.price_for_night;
+			return a.hotel < b.hotel;
+		};
+	return [](const FoundRoomInfo &a, const FoundRoomInfo &b) {
+		if (a.price_for_night != b.price_for_night)
+			return a.price_for_night < b.price_for_night;
+		if (a.from_date != b.from_date)
+			return a.from_date < b.from_date;
+		return a.hotel < b.hotel;
+	};
+}
+
+#endif /* HEADERS_RANKED_RESULTS_HPP_ */
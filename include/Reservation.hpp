@@ -5,6 +5,7 @@
  *          - Printable interface for output
  *          - Priced interface for cost calculation
  *          - Clone capability for polymorphic copying
+ *          - Booking and cancellation with the provider, blocking or as coroutines
  *
  * @author Abdallah Salem
  */
@@ -16,6 +17,7 @@
 #include <memory>
 #include <algorithm>
 #include "Properties.hpp"
+#include "Async_Call.hpp"
 
 /**
  * @class Reservation
@@ -30,6 +32,51 @@ public:
 	 */
 	virtual std::unique_ptr<Reservation> clone() const = 0;
 
+	/**
+	 * @brief Books the reservation with its provider.
+	 * @details Blocks until makeReservationAsync() has run on the shared event loop.
+	 * @return True if the reservation is successfully made, false otherwise.
+	 */
+	virtual bool makeReservation() {
+		return syncWait(EventLoop::instance(),
+				makeReservationAsync(EventLoop::instance()));
+	}
+
+	/**
+	 * @brief Cancels the reservation with its provider.
+	 * @details Blocks until cancelReservationAsync() has run on the shared event loop.
+	 * @return True if the reservation is successfully canceled, false otherwise.
+	 */
+	virtual bool cancelReservation() {
+		return syncWait(EventLoop::instance(),
+				cancelReservationAsync(EventLoop::instance()));
+	}
+
+	/**
+	 * @brief Books the reservation without holding a thread while the provider answers.
+	 * @details The reservation must outlive the task.
+	 * @param loop The loop the call waits on.
+	 * @return True if the reservation is successfully made, false otherwise.
+	 */
+	virtual Task<bool> makeReservationAsync(EventLoop &loop) = 0;
+
+	/**
+	 * @brief Cancels the reservation without holding a thread while the provider answers.
+	 * @details The reservation must outlive the task.
+	 * @param loop The loop the call waits on.
+	 * @return True if the reservation is successfully canceled, false otherwise.
+	 */
+	virtual Task<bool> cancelReservationAsync(EventLoop &loop) = 0;
+
+	/**
+	 * @brief Collects the reservations that are booked one provider call each.
+	 * @details A single reservation adds itself; composites add their parts instead.
+	 * @param bookings Receives pointers that stay valid while this reservation lives.
+	 */
+	virtual void appendBookings(std::vector<Reservation*> &bookings) {
+		bookings.push_back(this);
+	}
+
 	/**
 	 * @brief Virtual destructor for Reservation.
 	 * @details Ensures proper cleanup of derived classes.
@@ -43,4 +90,12 @@ public:
  */
 typedef std::unique_ptr<Reservation> Reservation_ptr;
 
+/**
+ * @typedef SharedReservation
+ * @brief Reservation shared by every itinerary holding it.
+ * @details A reservation is not changed once it is in an itinerary (booking only talks to
+ *          the provider), so copies of an itinerary share it instead of cloning it.
+ */
+typedef std::shared_ptr<Reservation> SharedReservation;
+
 #endif /* HEADERS_RESERVATION_HPP_ */
@@ -0,0 +1,61 @@
+/**
+ * @file Reservation_Value.hpp
+ * @brief Value-typed representation of booked reservations
+ * @details Provides:
+ *          - ReservationValue: Closed variant over the concrete flight and hotel kinds, the
+ *            element type of an itinerary's reservations
+ *          - std::visit dispatch of cost, details and booking over the kinds
+ *
+ *          The values hold the adapters themselves rather than pointers to them, so summing
+ *          or printing an itinerary makes no virtual call and follows no pointer per
+ *          reservation. Anything else (a nested itinerary) is held as a shared pointer.
+ *
+ * @author Abdallah Salem
+ */
+#ifndef HEADERS_RESERVATION_VALUE_HPP_
+#define HEADERS_RESERVATION_VALUE_HPP_
+
+#include <variant>
+#include <vector>
+#include <ostream>
+#include "Airports.hpp"
+#include "Hotels.hpp"
+
+/**
+ * @typedef ReservationValue
+ * @brief One booked flight or hotel, held by value, or any other reservation, shared.
+ * @details The kinds are closed: a new adapter is added here as well as to the registry.
+ */
+typedef std::variant<CanadaFlightReservation, TurkishFlightReservation,
+		HiltonHotelReservation, MarriottHotelReservation, SharedReservation> ReservationValue;
+
+/**
+ * @brief Moves a reservation into a value.
+ * @param reservation The reservation; moved inline if it is one of the kinds, shared otherwise.
+ * @return The value.
+ */
+ReservationValue toValue(Reservation_ptr &&reservation);
+
+/**
+ * @brief Calculates the cost of a reservation value.
+ * @param reservation The reservation.
+ * @return Its cost.
+ */
+Money getCost(const ReservationValue &reservation);
+
+/**
+ * @brief Outputs the details of a reservation value.
+ * @param reservation The reservation.
+ * @param get Output stream to write the details to.
+ */
+void getDetails(const ReservationValue &reservation, std::ostream &&get);
+
+/**
+ * @brief Collects the bookings of a reservation value.
+ * @param reservation The reservation.
+ * @param bookings Receives pointers that stay valid while the value lives.
+ */
+void appendBookings(ReservationValue &reservation,
+		std::vector<Reservation*> &bookings);
+
+#endif /* HEADERS_RESERVATION_VALUE_HPP_ */
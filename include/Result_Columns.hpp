@@ -0,0 +1,280 @@
+/**
+ * @file Result_Columns.hpp
+ * @brief Columnar containers for search results and the kernels that scan them
+ * @details Contains:
+ *          - FlightColumns: Flight offers stored one field per contiguous array
+ *          - RoomColumns: Room offers stored one field per contiguous array
+ *          - Selection kernels: branch-free range filters and min/max over a column
+ *          - FlightFilter / RoomFilter: The bounds a search keeps its offers within
+ *
+ *          The kernels are plain loops over contiguous integers with no branches in their
+ *          bodies, written so the compiler vectorizes them. Prices are kept in cents.
+ *
+ * @author Abdallah Salem
+ */
+#ifndef HEADERS_RESULT_COLUMNS_HPP_
+#define HEADERS_RESULT_COLUMNS_HPP_
+
+#include <vector>
+#include <string>
+#include <limits>
+#include <cstdint>
+#include "Flight_Reservation_Info.hpp"
+#include "Hotel_Reservation_Info.hpp"
+
+/**
+ * @typedef Selection
+ * @brief One byte per row, 1 if the row is still selected, 0 otherwise.
+ */
+typedef std::vector<std::uint8_t> Selection;
+
+/**
+ * @class FlightColumns
+ * @brief Flight offers split into one array per field.
+ */
+class FlightColumns {
+public:
+	std::vector<std::int64_t> price;   ///< Ticket price of each offer, in cents.
+	std::vector<CurrencyCode> currency; ///< Currency of each price.
+	std::vector<std::int32_t> departure; ///< Departure, minutes since 01-01-1970.
+	std::vector<std::int32_t> arrival;   ///< Arrival, minutes since 01-01-1970.
+	std::vector<ProviderId> airline;   ///< Airline of each offer.
+
+	/**
+	 * @brief Appends one offer.
+	 * @param airline ID of the airline.
+	 * @param price Ticket price.
+	 * @param departure Departure date and time.
+	 * @param arrival Arrival date and time.
+	 */
+	void append(ProviderId airline, const Money &price, DateTime departure,
+			DateTime arrival);
+
+	/**
+	 * @brief Appends one offer given as a record.
+	 * @param flight The offer.
+	 */
+	void append(const FoundFlightInfo &flight);
+
+	/**
+	 * @brief Reserves room for a number of offers in every column.
+	 * @param rows Number of offers.
+	 */
+	void reserve(std::size_t rows);
+
+	/**
+	 * @brief Gets the number of offers.
+	 * @return Number of rows.
+	 */
+	std::size_t size() const;
+
+	/**
+	 * @brief Rebuilds one offer as a record.
+	 * @param index Row of the offer.
+	 * @return The offer.
+	 */
+	FoundFlightInfo row(std::size_t index) const;
+
+	/**
+	 * @brief Rebuilds the selected offers as records.
+	 * @param selection Rows to rebuild.
+	 * @return The offers, in row order.
+	 */
+	std::vector<FoundFlightInfo> rows(const Selection &selection) const;
+};
+
+/**
+ * @class RoomColumns
+ * @brief Room offers split into one array per field.
+ * @details The room type is the only text field; it sits in its own column and is
+ *          only touched when a row is turned back into a record.
+ */
+class RoomColumns {
+public:
+	std::vector<std::int64_t> price_per_night; ///< Price per night of each offer, in cents.
+	std::vector<CurrencyCode> currency;  ///< Currency of each price.
+	std::vector<std::int32_t> check_in;  ///< Check-in, days since 01-01-1970.
+	std::vector<std::int32_t> check_out; ///< Check-out, days since 01-01-1970.
+	std::vector<std::int32_t> available; ///< Rooms available of each offer.
+	std::vector<ProviderId> hotel;       ///< Hotel chain of each offer.
+	std::vector<std::string> view_type;  ///< Room type of each offer.
+
+	/**
+	 * @brief Appends one offer.
+	 * @param hotel ID of the hotel chain.
+	 * @param check_in Check-in date.
+	 * @param check_out Check-out date.
+	 * @param view_type Room type.
+	 * @param available Rooms available.
+	 * @param price_per_night Price per night.
+	 */
+	void append(ProviderId hotel, Date check_in, Date check_out,
+			const std::string &view_type, int available, const Money &price_per_night);
+
+	/**
+	 * @brief Appends one offer given as a record.
+	 * @param room The offer.
+	 */
+	void append(const FoundRoomInfo &room);
+
+	/**
+	 * @brief Reserves room for a number of offers in every column.
+	 * @param rows Number of offers.
+	 */
+	void reserve(std::size_t rows);
+
+	/**
+	 * @brief Gets the number of offers.
+	 * @return Number of rows.
+	 */
+	std::size_t size() const;
+
+	/**
+	 * @brief Rebuilds one offer as a record.
+	 * @param index Row of the offer.
+	 * @return The offer.
+	 */
+	FoundRoomInfo row(std::size_t index) const;
+
+	/**
+	 * @brief Rebuilds the selected offers as records.
+	 * @param selection Rows to rebuild.
+	 * @return The offers, in row order.
+	 */
+	std::vector<FoundRoomInfo> rows(const Selection &selection) const;
+};
+
+/**
+ * @brief Creates a selection holding every row.
+ * @param rows Number of rows.
+ * @return A selection of ones.
+ */
+Selection selectAll(std::size_t rows);
+
+/**
+ * @brief Deselects rows whose value lies outside [low, high].
+ * @param column The column to test (prices in cents).
+ * @param low Smallest accepted value.
+ * @param high Largest accepted value.
+ * @param selection Selection narrowed in place.
+ */
+void keepInRange(const std::vector<std::int64_t> &column, std::int64_t low,
+		std::int64_t high, Selection &selection);
+
+/**
+ * @brief Deselects rows whose value lies outside [low, high].
+ * @param column The column to test (dates, counts).
+ * @param low Smallest accepted value.
+ * @param high Largest accepted value.
+ * @param selection Selection narrowed in place.
+ */
+void keepInRange(const std::vector<std::int32_t> &column, std::int32_t low,
+		std::int32_t high, Selection &selection);
+
+/**
+ * @brief Deselects rows whose value is below a minimum (e.g. needed_rooms <= available).
+ * @param column The column to test.
+ * @param minimum Smallest accepted value.
+ * @param selection Selection narrowed in place.
+ */
+void keepAtLeast(const std::vector<std::int32_t> &column, std::int32_t minimum,
+		Selection &selection);
+
+/**
+ * @brief Counts the selected rows.
+ * @param selection The selection.
+ * @return Number of ones.
+ */
+std::size_t countSelected(const Selection &selection);
+
+/**
+ * @brief Lists the selected rows.
+ * @param selection The selection.
+ * @return Row indexes in ascending order.
+ */
+std::vector<std::uint32_t> selectedRows(const Selection &selection);
+
+/**
+ * @brief Finds the smallest and largest value among the selected rows.
+ * @param column The column to scan.
+ * @param selection Rows taking part.
+ * @param low Receives the minimum.
+ * @param high Receives the maximum.
+ * @return False if no row is selected (low and high are left untouched).
+ */
+bool minMax(const std::vector<std::int64_t> &column, const Selection &selection,
+		std::int64_t &low, std::int64_t &high);
+
+/**
+ * @class FlightFilter
+ * @brief Bounds the flight offers of a search are kept within.
+ */
+class FlightFilter {
+public:
+	/// Lowest ticket price accepted, in cents.
+	std::int64_t lowest_price { };
+	/// Highest ticket price accepted, in cents.
+	std::int64_t highest_price { std::numeric_limits<std::int64_t>::max() };
+	/// Earliest departure accepted, minutes since 01-01-1970.
+	std::int32_t earliest_departure { std::numeric_limits<std::int32_t>::min() };
+	/// Latest departure accepted, minutes since 01-01-1970.
+	std::int32_t latest_departure { std::numeric_limits<std::int32_t>::max() };
+
+	/**
+	 * @brief Builds the bounds of a passenger request.
+	 * @details Flights have to leave between the start of the departure date and the end
+	 *          of the return date, for a ticket price within the given range.
+	 * @param query The request.
+	 * @param lowest Lowest ticket price.
+	 * @param highest Highest ticket price; zero for no limit.
+	 * @return The filter.
+	 */
+	static FlightFilter forQuery(const PassengerInfo &query, const Money &lowest,
+			const Money &highest);
+
+	/**
+	 * @brief Selects the offers within the bounds.
+	 * @param columns The offers.
+	 * @return One entry per row, set if the offer is kept.
+	 */
+	Selection select(const FlightColumns &columns) const;
+};
+
+/**
+ * @class RoomFilter
+ * @brief Bounds the room offers of a search are kept within.
+ */
+class RoomFilter {
+public:
+	/// Lowest price per night accepted, in cents.
+	std::int64_t lowest_price { };
+	/// Highest price per night accepted, in cents.
+	std::int64_t highest_price { std::numeric_limits<std::int64_t>::max() };
+	/// Latest check-in accepted, days since 01-01-1970.
+	std::int32_t latest_check_in { std::numeric_limits<std::int32_t>::max() };
+	/// Earliest check-out accepted, days since 01-01-1970.
+	std::int32_t earliest_check_out { std::numeric_limits<std::int32_t>::min() };
+	/// Rooms an offer must have available.
+	std::int32_t needed_rooms { 1 };
+
+	/**
+	 * @brief Builds the bounds of a customer request.
+	 * @details Rooms have to be available for the whole stay, in the number needed (at
+	 *          least one), for a price per night within the given range.
+	 * @param query The request.
+	 * @param lowest Lowest price per night.
+	 * @param highest Highest price per night; zero for no limit.
+	 * @return The filter.
+	 */
+	static RoomFilter forQuery(const CustomerInfo &query, const Money &lowest,
+			const Money &highest);
+
+	/**
+	 * @brief Selects the offers within the bounds.
+	 * @param columns The offers.
+	 * @return One entry per row, set if the offer is kept.
+	 */
+	Selection select(const RoomColumns &columns) const;
+};
+
+#endif /* HEADERS_RESULT_COLUMNS_HPP_ */
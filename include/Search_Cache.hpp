@@ -0,0 +1,237 @@
+/**
+ * @file Search_Cache.hpp
+ * @brief Bounded cache for provider search results
+ * @details Provides:
+ *          - CacheStats: Hit/miss/eviction counters of a cache
+ *          - SearchStats: Cache counters and coalesced searches of one provider
+ *          - SearchCache: Thread-safe LRU cache with a per-instance time-to-live
+ *          - normalizeSearchText: Canonical form of free-text key parts
+ *
+ * @author Abdallah Salem
+ */
+#ifndef HEADERS_SEARCH_CACHE_HPP_
+#define HEADERS_SEARCH_CACHE_HPP_
+
+#include <list>
+#include <mutex>
+#include <string>
+#include <chrono>
+#include <cctype>
+#include <ostream>
+#include <iterator>
+#include <functional>
+#include <unordered_map>
+
+/**
+ * @brief Trims and upper-cases a free-text search term.
+ * @details Used when building cache keys so "cairo " and "Cairo" share an entry.
+ * @param text The term as typed by the user.
+ * @return The normalized term.
+ */
+inline std::string normalizeSearchText(const std::string &text) {
+	std::size_t first = text.find_first_not_of(" \t");
+	std::size_t last = text.find_last_not_of(" \t");
+	std::string normalized;
+	if (first == std::string::npos)
+		return normalized;
+	for (std::size_t i = first; i <= last; i++)
+		normalized += (char) std::toupper((unsigned char) text[i]);
+	return normalized;
+}
+
+/**
+ * @class CacheStats
+ * @brief Snapshot of a cache's counters.
+ */
+class CacheStats {
+public:
+	/// Lookups answered from the cache.
+	std::size_t hits { };
+	/// Lookups that had to go to the provider (absent or expired).
+	std::size_t misses { };
+	/// Entries dropped to stay within capacity.
+	std::size_t evictions { };
+	/// Entries currently held.
+	std::size_t size { };
+};
+
+/**
+ * @class SearchStats
+ * @brief Snapshot of one provider's search pipeline.
+ */
+class SearchStats {
+public:
+	/// Provider name.
+	std::string provider;
+	/// Counters of its search cache.
+	CacheStats cache;
+	/// Searches served by another search's provider call.
+	std::size_t coalesced { };
+};
+
+/**
+ * @brief Writes a snapshot as one line.
+ * @param out Output stream to write to.
+ * @param stats The snapshot.
+ * @return Reference to the output stream.
+ */
+inline std::ostream& operator<<(std::ostream &out, const SearchStats &stats) {
+	out << stats.provider << ": cache hits " << stats.cache.hits << ", misses "
+			<< stats.cache.misses << ", evictions " << stats.cache.evictions
+			<< ", size " << stats.cache.size << ", coalesced " << stats.coalesced;
+	return out;
+}
+
+/**
+ * @class SearchCache
+ * @brief Least-recently-used cache whose entries expire after a fixed time-to-live.
+ * @details Keys are normalized search strings built by the adapters. Memory is bounded by
+ *          the entry capacity; the least recently used entry is evicted first. Expired
+ *          entries are no longer served by get() but stay readable through getStale()
+ *          until they are replaced or evicted.
+ * @tparam Value The cached provider answer (e.g. std::vector<AirCanadaFlight>).
+ */
+template<typename Value>
+class SearchCache {
+private:
+	typedef std::chrono::steady_clock Clock;
+
+	/**
+	 * @class Entry
+	 * @brief A cached value with its key and expiry time.
+	 */
+	class Entry {
+	public:
+		std::string key;          ///< Normalized search key.
+		Value value;              ///< Cached provider answer.
+		Clock::time_point expires; ///< Moment the entry stops being served.
+	};
+
+	/// Entries ordered from most to least recently used.
+	std::list<Entry> entries;
+	/// Key lookup into the recency list.
+	std::unordered_map<std::string, typename std::list<Entry>::iterator> index;
+	/// Maximum number of entries held.
+	std::size_t capacity;
+	/// Lifetime of an entry.
+	std::chrono::seconds ttl;
+	/// Counters reported by stats().
+	CacheStats counters;
+	/// Guards every member, the cache is shared by concurrent searches.
+	mutable std::mutex lock;
+
+	/**
+	 * @brief Removes an entry from both the list and the index.
+	 * @param it Iterator to the entry to remove.
+	 */
+	void erase(typename std::list<Entry>::iterator it) {
+		index.erase(it->key);
+		entries.erase(it);
+	}
+
+public:
+	/**
+	 * @brief Constructs an empty cache.
+	 * @param capacity Maximum number of entries (at least one).
+	 * @param ttl Lifetime of each entry.
+	 */
+	SearchCache(std::size_t capacity, std::chrono::seconds ttl) :
+			capacity(capacity ? capacity : 1), ttl(ttl) {
+	}
+
+	/**
+	 * @brief Looks up a fresh entry and marks it as recently used.
+	 * @param key Normalized search key.
+	 * @param value Receives a copy of the cached value on a hit.
+	 * @return True on a hit, false if the key is absent or expired.
+	 */
+	bool get(const std::string &key, Value &value) {
+		std::lock_guard<std::mutex> guard(lock);
+		auto found = index.find(key);
+		if (found == index.end()) {
+			counters.misses++;
+			return false;
+		}
+		//expired entries stay until replaced or evicted, for getStale().
+		if (found->second->expires <= Clock::now()) {
+			counters.misses++;
+			return false;
+		}
+		entries.splice(entries.begin(), entries, found->second);
+		value = found->second->value;
+		counters.hits++;
+		return true;
+	}
+
+	/**
+	 * @brief Looks up an entry even if it has expired, for when the provider cannot answer.
+	 * @param key Normalized search key.
+	 * @param value Receives a copy of the cached value if one is held.
+	 * @return True if an entry was found, fresh or not.
+	 */
+	bool getStale(const std::string &key, Value &value) const {
+		std::lock_guard<std::mutex> guard(lock);
+		auto found = index.find(key);
+		if (found == index.end())
+			return false;
+		value = found->second->value;
+		return true;
+	}
+
+	/**
+	 * @brief Inserts or refreshes an entry, evicting the least recently used one if full.
+	 * @param key Normalized search key.
+	 * @param value Provider answer to cache.
+	 */
+	void put(const std::string &key, Value value) {
+		std::lock_guard<std::mutex> guard(lock);
+		auto found = index.find(key);
+		if (found != index.end())
+			erase(found->second);
+		else if (entries.size() >= capacity) {
+			erase(std::prev(entries.end()));
+			counters.evictions++;
+		}
+		entries.push_front(Entry { key, std::move(value), Clock::now() + ttl });
+		index[key] = entries.begin();
+	}
+
+	/**
+	 * @brief Modifies a fresh entry in place, without touching its recency or expiry.
+	 * @details Lets adapters reconcile cached answers with their own reservations
+	 *          instead of dropping them and refetching.
+	 * @param key Normalized search key.
+	 * @param change Mutation applied to the cached value.
+	 * @return True if a fresh entry was found and changed, false otherwise.
+	 */
+	bool update(const std::string &key, const std::function<void(Value&)> &change) {
+		std::lock_guard<std::mutex> guard(lock);
+		auto found = index.find(key);
+		if (found == index.end() || found->second->expires <= Clock::now())
+			return false;
+		change(found->second->value);
+		return true;
+	}
+
+	/**
+	 * @brief Drops every entry; counters are kept.
+	 */
+	void clear() {
+		std::lock_guard<std::mutex> guard(lock);
+		entries.clear();
+		index.clear();
+	}
+
+	/**
+	 * @brief Returns a snapshot of the cache counters.
+	 * @return Hits, misses, evictions and current size.
+	 */
+	CacheStats stats() const {
+		std::lock_guard<std::mutex> guard(lock);
+		CacheStats snapshot = counters;
+		snapshot.size = entries.size();
+		return snapshot;
+	}
+};
+
+#endif /* HEADERS_SEARCH_CACHE_HPP_ */
@@ -0,0 +1,379 @@
+/**
+ * @file Search_Fan_Out.hpp
+ * @brief Concurrent search stage for provider adapters
+ * @details Provides:
+ *          - WorkerPool: Fixed set of threads running submitted tasks
+ *          - SearchResults: Shared result sink filled as providers answer
+ *          - SearchFanOut: Queries every adapter in parallel under a deadline, returning
+ *            the merged answer or streaming batches as providers answer
+ *
+ * @author Abdallah Salem
+ */
+#ifndef HEADERS_SEARCH_FAN_OUT_HPP_
+#define HEADERS_SEARCH_FAN_OUT_HPP_
+
+#include <vector>
+#include <queue>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <chrono>
+#include <functional>
+#include <condition_variable>
+
+/**
+ * @class WorkerPool
+ * @brief Fixed-size pool of worker threads executing queued tasks.
+ * @details Tasks are run in submission order by the first idle worker. The destructor
+ *          drains the queue and joins every worker, so a pool must outlive anything its
+ *          tasks reference.
+ */
+class WorkerPool {
+private:
+	/// Threads owned by the pool.
+	std::vector<std::thread> workers;
+	/// Tasks waiting for an idle worker.
+	std::queue<std::function<void()>> tasks;
+	/// Guards the task queue and the stopping flag.
+	std::mutex lock;
+	/// Signals workers that a task arrived or the pool is stopping.
+	std::condition_variable wake;
+	/// Set once the pool is being destroyed.
+	bool stopping { };
+
+	/**
+	 * @brief Worker loop: pops and runs tasks until the pool stops.
+	 */
+	void work();
+
+public:
+	/**
+	 * @brief Starts the given number of worker threads.
+	 * @param threads Number of workers (at least one is started).
+	 */
+	explicit WorkerPool(std::size_t threads);
+
+	/**
+	 * @brief Deleted copy constructor; workers cannot be shared.
+	 */
+	WorkerPool(const WorkerPool &other) = delete;
+
+	/**
+	 * @brief Deleted copy assignment operator.
+	 */
+	WorkerPool& operator=(const WorkerPool &other) = delete;
+
+	/**
+	 * @brief Queues a task for execution on a worker thread.
+	 * @param task The task to run.
+	 */
+	void submit(std::function<void()> task);
+
+	/**
+	 * @brief Finishes queued tasks and joins all workers.
+	 */
+	~WorkerPool();
+};
+
+/**
+ * @typedef WorkerPool_ptr
+ * @brief Smart pointer to a WorkerPool object.
+ */
+typedef std::unique_ptr<WorkerPool> WorkerPool_ptr;
+
+/**
+ * @class SearchResults
+ * @brief Result sink shared between a search and the provider tasks feeding it.
+ * @details Providers may append any number of batches and then finish exactly once.
+ *          Batches arriving after the caller has stopped reading are kept alive by the
+ *          shared pointer and then dropped.
+ * @tparam Info The result record type (FoundFlightInfo or FoundRoomInfo).
+ */
+template<typename Info>
+class SearchResults {
+private:
+	/// Guards results and pending.
+	std::mutex lock;
+	/// Signalled whenever a provider appends or finishes.
+	std::condition_variable arrived;
+	/// Results merged in arrival order and not yet handed to the caller.
+	std::vector<Info> results;
+	/// Number of providers that have not finished yet.
+	std::size_t pending { };
+
+public:
+	/**
+	 * @brief Creates a sink expecting every provider to finish once.
+	 * @param providers Number of providers queried.
+	 */
+	explicit SearchResults(std::size_t providers) :
+			pending(providers) {
+	}
+
+	/**
+	 * @brief Merges part of a provider's answer into the results.
+	 * @param batch Results found so far by one provider.
+	 */
+	void append(std::vector<Info> &&batch) {
+		if (batch.empty())
+			return;
+		{
+			std::lock_guard<std::mutex> guard(lock);
+			for (auto &info : batch)
+				results.push_back(std::move(info));
+		}
+		arrived.notify_all();
+	}
+
+	/**
+	 * @brief Records that a provider has nothing more to send.
+	 */
+	void finish() {
+		{
+			std::lock_guard<std::mutex> guard(lock);
+			--pending;
+		}
+		arrived.notify_all();
+	}
+
+	/**
+	 * @brief Merges a provider's complete answer and finishes it.
+	 * @param batch Results found by one provider.
+	 */
+	void deliver(std::vector<Info> &&batch) {
+		append(std::move(batch));
+		finish();
+	}
+
+	/**
+	 * @brief Waits until every provider answered or the deadline passes.
+	 * @param deadline Point in time after which the search stops waiting.
+	 * @return True if all providers answered in time, false otherwise.
+	 */
+	bool waitUntil(std::chrono::steady_clock::time_point deadline) {
+		std::unique_lock<std::mutex> guard(lock);
+		return arrived.wait_until(guard, deadline, [this] {
+			return pending == 0;
+		});
+	}
+
+	/**
+	 * @brief Waits for results not yet handed out.
+	 * @param deadline Point in time after which the search stops waiting.
+	 * @param batch Receives every result arrived since the previous call.
+	 * @return False once all providers finished and everything was handed out, or the
+	 *         deadline passed with nothing new.
+	 */
+	bool next(std::chrono::steady_clock::time_point deadline,
+			std::vector<Info> &batch) {
+		std::unique_lock<std::mutex> guard(lock);
+		arrived.wait_until(guard, deadline, [this] {
+			return !results.empty() || pending == 0;
+		});
+		if (results.empty())
+			return false;
+		batch = std::move(results);
+		results.clear();
+		return true;
+	}
+
+	/**
+	 * @brief Moves out whatever has arrived so far.
+	 * @return The merged results.
+	 */
+	std::vector<Info> take() {
+		std::lock_guard<std::mutex> guard(lock);
+		return std::move(results);
+	}
+};
+
+/**
+ * @class SearchFanOut
+ * @brief Runs one search on every registered adapter in parallel.
+ * @details Every adapter is queried on the worker pool and the caller waits at most the
+ *          configured deadline; providers that miss it are left out of the results.
+ *          An adapter still answering a previous search is searched again by the worker
+ *          that frees it, if this search's deadline has not passed by then. Only the newest
+ *          search waits for an adapter, so a hung provider holds at most one worker and
+ *          never queues more than one search behind it.
+ * @tparam Provider Adapter interface (FlightReservation or HotelReservation).
+ * @tparam Info Result record type produced by the adapter.
+ */
+template<typename Provider, typename Info>
+class SearchFanOut {
+public:
+	/**
+	 * @typedef Search
+	 * @brief Search operation applied to each adapter, filling the given vector.
+	 */
+	typedef std::function<void(Provider&, std::vector<Info>&&)> Search;
+
+	/**
+	 * @typedef Batch
+	 * @brief Receiver of one batch of results.
+	 */
+	typedef std::function<void(std::vector<Info>&&)> Batch;
+
+	/**
+	 * @typedef StreamSearch
+	 * @brief Search operation applied to each adapter, passing batches to the receiver as
+	 *        they are found.
+	 */
+	typedef std::function<void(Provider&, const Batch&)> StreamSearch;
+
+private:
+	/**
+	 * @class Slot
+	 * @brief One adapter's in-flight search and the search waiting for it.
+	 */
+	class Slot {
+	public:
+		/// Guards every field.
+		std::mutex lock;
+		/// Set while a worker is searching the adapter.
+		bool busy { };
+		/// Adapter of the waiting search.
+		Provider *waiting_provider { };
+		/// Operation of the waiting search.
+		StreamSearch waiting_search;
+		/// Sink of the waiting search; null when no search waits.
+		std::shared_ptr<SearchResults<Info>> waiting_results;
+		/// Point in time after which the waiting search's caller stops reading.
+		std::chrono::steady_clock::time_point waiting_until;
+	};
+
+	/// Pool the provider calls run on.
+	WorkerPool &pool;
+	/// One slot per adapter, shared with in-flight tasks.
+	std::vector<std::shared_ptr<Slot>> slots;
+	/// Maximum time a search waits for its providers.
+	std::chrono::milliseconds deadline;
+
+	/**
+	 * @brief Searches an adapter, then every search that waited for it meanwhile.
+	 * @details Runs on a worker, which frees the slot once nothing waits.
+	 * @param slot The adapter's slot, already marked busy.
+	 * @param provider The adapter.
+	 * @param search The operation run against it.
+	 * @param results The sink it feeds.
+	 * @param until Point in time after which the search is not worth starting.
+	 */
+	static void answer(const std::shared_ptr<Slot> &slot, Provider *provider,
+			StreamSearch search, std::shared_ptr<SearchResults<Info>> results,
+			std::chrono::steady_clock::time_point until) {
+		while (true) {
+			if (std::chrono::steady_clock::now() < until) {
+				try {
+					search(*provider, [&results](std::vector<Info> &&batch) {
+						results->append(std::move(batch));
+					});
+				} catch (...) {
+					//a failing provider ends its answer with what it sent so far.
+				}
+			}
+			results->finish();
+			std::lock_guard<std::mutex> guard(slot->lock);
+			if (!slot->waiting_results) {
+				slot->busy = false;
+				return;
+			}
+			provider = slot->waiting_provider;
+			search = std::move(slot->waiting_search);
+			results = std::move(slot->waiting_results);
+			until = slot->waiting_until;
+		}
+	}
+
+	/**
+	 * @brief Submits the search of every adapter to the pool.
+	 * @details A busy adapter gets the search as its waiting one; a search it replaces
+	 *          gives up on that adapter.
+	 * @param providers The registered adapters.
+	 * @param search The operation run against each adapter.
+	 * @param until Point in time after which the caller stops reading.
+	 * @return The sink the adapters feed.
+	 */
+	std::shared_ptr<SearchResults<Info>> launch(
+			const std::vector<std::unique_ptr<Provider>> &providers,
+			const StreamSearch &search,
+			std::chrono::steady_clock::time_point until) {
+		while (slots.size() < providers.size())
+			slots.push_back(std::make_shared<Slot>());
+		auto results = std::make_shared<SearchResults<Info>>(providers.size());
+		for (std::size_t i = 0; i < providers.size(); i++) {
+			Provider *provider = providers[i].get();
+			std::shared_ptr<Slot> slot = slots[i];
+			std::shared_ptr<SearchResults<Info>> replaced;
+			bool waiting;
+			{
+				std::lock_guard<std::mutex> guard(slot->lock);
+				waiting = slot->busy;
+				if (waiting) {
+					replaced = std::move(slot->waiting_results);
+					slot->waiting_provider = provider;
+					slot->waiting_search = search;
+					slot->waiting_results = results;
+					slot->waiting_until = until;
+				} else
+					slot->busy = true;
+			}
+			if (replaced)
+				replaced->finish();
+			if (waiting)
+				continue;
+			pool.submit([slot, provider, search, results, until] {
+				answer(slot, provider, search, results, until);
+			});
+		}
+		return results;
+	}
+
+public:
+	/**
+	 * @brief Constructs a fan-out stage on the given pool.
+	 * @param pool Worker pool used for provider calls.
+	 * @param deadline Maximum time a search waits for its providers.
+	 */
+	SearchFanOut(WorkerPool &pool, std::chrono::milliseconds deadline) :
+			pool(pool), deadline(deadline) {
+	}
+
+	/**
+	 * @brief Queries all adapters concurrently and merges their answers.
+	 * @param providers The registered adapters.
+	 * @param search The operation run against each adapter.
+	 * @return Results of every provider that answered before the deadline.
+	 */
+	std::vector<Info> search(const std::vector<std::unique_ptr<Provider>> &providers,
+			const Search &search) {
+		auto until = std::chrono::steady_clock::now() + deadline;
+		auto results = launch(providers,
+				[search](Provider &provider, const Batch &batch) {
+					std::vector<Info> found;
+					search(provider, std::move(found));
+					batch(std::move(found));
+				}, until);
+		results->waitUntil(until);
+		return results->take();
+	}
+
+	/**
+	 * @brief Queries all adapters concurrently and hands over results as they arrive.
+	 * @details The receiver runs on the calling thread, once per group of results that
+	 *          arrived together, so it may print without further locking. Returns when
+	 *          every provider finished or the deadline passed.
+	 * @param providers The registered adapters.
+	 * @param search The operation run against each adapter.
+	 * @param receive Called with each new group of results.
+	 */
+	void stream(const std::vector<std::unique_ptr<Provider>> &providers,
+			const StreamSearch &search, const Batch &receive) {
+		auto until = std::chrono::steady_clock::now() + deadline;
+		auto results = launch(providers, search, until);
+		std::vector<Info> batch;
+		while (results->next(until, batch))
+			receive(std::move(batch));
+	}
+};
+
+#endif /* HEADERS_SEARCH_FAN_OUT_HPP_ */
@@ -0,0 +1,74 @@
+/**
+ * @file Session_Arena.hpp
+ * @brief Per-session memory arena for itinerary building
+ * @details Provides:
+ *          - SessionArena: Monotonic memory resource rewound at the start of every search
+ *            and released in bulk when the itinerary is saved or cancelled
+ *
+ * @author Abdallah Salem
+ */
+#ifndef HEADERS_SESSION_ARENA_HPP_
+#define HEADERS_SESSION_ARENA_HPP_
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+
+/**
+ * @class SessionArena
+ * @brief Bump allocator for the scratch of the searches of one itinerary being built.
+ * @details Allocations are never freed one by one; release() frees them all at once, and
+ *          every search starts with it, so the arena holds one search's scratch at most. The
+ *          first block is part of the arena itself, so a typical session allocates nothing
+ *          from the heap. Only what dies with a search may live here, which leaves the
+ *          search's merged result list: requests and reservations are shared with saved
+ *          itineraries and outlive the arena, and provider batches are filled on pool
+ *          threads, which a monotonic resource is not safe for.
+ */
+class SessionArena {
+private:
+	/// Size of the block held inline.
+	static const std::size_t INITIAL_BLOCK = 16 * 1024;
+
+	/// First block, used before the heap is.
+	alignas(std::max_align_t) std::array<std::byte, INITIAL_BLOCK> initial_block;
+	/// The monotonic resource carving allocations out of the blocks.
+	std::pmr::monotonic_buffer_resource arena;
+
+public:
+	/**
+	 * @brief Constructs an empty arena.
+	 */
+	SessionArena();
+
+	/**
+	 * @brief Deleted copy constructor; containers point into the arena.
+	 */
+	SessionArena(const SessionArena &other) = delete;
+
+	/**
+	 * @brief Deleted copy assignment operator.
+	 */
+	SessionArena& operator=(const SessionArena &other) = delete;
+
+	/**
+	 * @brief Gets the memory resource containers of the session allocate from.
+	 * @return The arena's resource.
+	 */
+	std::pmr::memory_resource* resource();
+
+	/**
+	 * @brief Frees every allocation at once.
+	 * @details Nothing allocated from the arena may be alive.
+	 */
+	void release();
+};
+
+/**
+ * @typedef SessionArena_ptr
+ * @brief Smart pointer to a SessionArena object.
+ */
+typedef std::unique_ptr<SessionArena> SessionArena_ptr;
+
+#endif /* HEADERS_SESSION_ARENA_HPP_ */
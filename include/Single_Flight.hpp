@@ -0,0 +1,206 @@
+/**
+ * @file Single_Flight.hpp
+ * @brief Coalescing of identical in-flight provider searches
+ * @details Provides:
+ *          - SingleFlight: Lets concurrent identical searches share one upstream call
+ *
+ * @author Abdallah Salem
+ */
+#ifndef HEADERS_SINGLE_FLIGHT_HPP_
+#define HEADERS_SINGLE_FLIGHT_HPP_
+
+#include <mutex>
+#include <memory>
+#include <string>
+#include <vector>
+#include <utility>
+#include <optional>
+#include <exception>
+#include <functional>
+#include <coroutine>
+#include <unordered_map>
+#include <condition_variable>
+#include "Async_Call.hpp"
+
+/**
+ * @class SingleFlight
+ * @brief Runs at most one upstream call per search key at a time.
+ * @details The first caller of a key (the leader) makes the call; callers arriving with the
+ *          same key while it is in flight wait for it and all get its result, or its
+ *          exception. Once the call has finished the key is free again, so it complements
+ *          a SearchCache: the cache answers repeated searches, this keeps a cold or
+ *          just-expired key from sending every concurrent search to the provider. Leaders
+ *          should fill the cache inside the call so no search slips in between.
+ *
+ *          Blocking and coroutine callers of the same key share one call; waiting
+ *          coroutines are resumed on their loop and hold no thread.
+ * @tparam Value The provider answer (e.g. std::vector<AirCanadaFlight>).
+ */
+template<typename Value>
+class SingleFlight {
+private:
+	/**
+	 * @class Call
+	 * @brief One upstream call and the callers waiting for it.
+	 */
+	class Call {
+	public:
+		/// Guards every member.
+		std::mutex lock;
+		/// Signalled to blocked callers when the call finishes.
+		std::condition_variable finished;
+		/// Set once the call has finished.
+		bool done { };
+		/// The answer, on success.
+		std::optional<Value> value;
+		/// The exception the call ended with.
+		std::exception_ptr error;
+		/// Coroutines to resume, with the loop each waits on.
+		std::vector<std::pair<EventLoop*, std::coroutine_handle<>>> waiting;
+
+		/**
+		 * @brief Gets the call's outcome.
+		 * @throws The call's exception.
+		 */
+		Value result() const {
+			if (error)
+				std::rethrow_exception(error);
+			return *value;
+		}
+	};
+
+	/**
+	 * @class Join
+	 * @brief Awaitable suspending a coroutine until a call finishes.
+	 */
+	class Join {
+	public:
+		/// The call waited for.
+		Call &call;
+		/// Loop to resume on.
+		EventLoop &loop;
+
+		bool await_ready() const noexcept {
+			return false;
+		}
+
+		bool await_suspend(std::coroutine_handle<> waiting) {
+			std::lock_guard<std::mutex> guard(call.lock);
+			if (call.done)
+				return false;
+			call.waiting.emplace_back(&loop, waiting);
+			return true;
+		}
+
+		void await_resume() const noexcept {
+		}
+	};
+
+	/// Calls in flight per search key.
+	std::unordered_map<std::string, std::shared_ptr<Call>> calls;
+	/// Searches that waited on another's call instead of making their own.
+	std::size_t coalesced_searches { };
+	/// Guards calls and the counter.
+	mutable std::mutex lock;
+
+	/**
+	 * @brief Gets the call in flight for a key, starting one if there is none.
+	 * @param key Search key.
+	 * @param leader Set to true if the caller must make the call.
+	 * @return The call.
+	 */
+	std::shared_ptr<Call> join(const std::string &key, bool &leader) {
+		std::lock_guard<std::mutex> guard(lock);
+		std::shared_ptr<Call> &call = calls[key];
+		leader = !call;
+		if (leader)
+			call = std::make_shared<Call>();
+		else
+			coalesced_searches++;
+		return call;
+	}
+
+	/**
+	 * @brief Frees the key and hands the outcome to every waiting caller.
+	 * @param key Search key.
+	 * @param call The finished call, its value or error already set.
+	 */
+	void finish(const std::string &key, Call &call) {
+		{
+			std::lock_guard<std::mutex> guard(lock);
+			calls.erase(key);
+		}
+		std::vector<std::pair<EventLoop*, std::coroutine_handle<>>> waiting;
+		{
+			std::lock_guard<std::mutex> guard(call.lock);
+			call.done = true;
+			waiting.swap(call.waiting);
+		}
+		call.finished.notify_all();
+		for (auto &waiter : waiting)
+			waiter.first->post(waiter.second);
+	}
+
+public:
+	/**
+	 * @brief Makes a call, or waits for the identical one already in flight.
+	 * @param key Normalized search key.
+	 * @param fetch The upstream call.
+	 * @return The call's answer.
+	 * @throws The call's exception.
+	 */
+	Value run(const std::string &key, const std::function<Value()> &fetch) {
+		bool leader;
+		std::shared_ptr<Call> call = join(key, leader);
+		if (leader) {
+			try {
+				call->value.emplace(fetch());
+			} catch (...) {
+				call->error = std::current_exception();
+			}
+			finish(key, *call);
+		} else {
+			std::unique_lock<std::mutex> guard(call->lock);
+			call->finished.wait(guard, [&] {
+				return call->done;
+			});
+		}
+		return call->result();
+	}
+
+	/**
+	 * @brief Makes a call, or awaits the identical one already in flight.
+	 * @param loop The loop to wait on.
+	 * @param key Normalized search key.
+	 * @param fetch Starts the upstream call.
+	 * @return The call's answer.
+	 * @throws The call's exception.
+	 */
+	Task<Value> runAsync(EventLoop &loop, std::string key,
+			std::function<Task<Value>()> fetch) {
+		bool leader;
+		std::shared_ptr<Call> call = join(key, leader);
+		if (leader) {
+			try {
+				Task<Value> upstream = fetch();
+				call->value.emplace(co_await upstream);
+			} catch (...) {
+				call->error = std::current_exception();
+			}
+			finish(key, *call);
+		} else
+			co_await Join { *call, loop };
+		co_return call->result();
+	}
+
+	/**
+	 * @brief Gets the number of searches served by another search's call.
+	 * @return Coalesced searches so far.
+	 */
+	std::size_t coalesced() const {
+		std::lock_guard<std::mutex> guard(lock);
+		return coalesced_searches;
+	}
+};
+
+#endif /* HEADERS_SINGLE_FLIGHT_HPP_ */
@@ -13,6 +13,7 @@
 
 #include <iostream>
 #include <memory>
+#include "Money.hpp"
 
 /**
  * @class TransactionInfo
@@ -34,7 +35,7 @@ public:
 	/// The card verification value (CCV).
 	int ccv { };
 	/// The amount of money for the transaction.
-	double money { };
+	Money money;
 
 	/**
 	 * @brief Default constructor for TransactionInfo.
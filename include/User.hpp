@@ -5,6 +5,7 @@
  *          - User credentials and profile information
  *          - Collection of user itineraries
  *          - Itinerary management operations
+ *          - Running total of every saved itinerary
  * @author Abdallah Salem
  * @date Created: Apr 15, 2025
  */
@@ -30,15 +31,10 @@ private:
 	std::string password;
 	/// User's email address.
 	std::string email;
-	/// Vector of smart pointers to the user's itineraries.
-	std::vector<Itinerary_ptr> Itineraries;
-
-	/**
-	 * @brief Dynamically casts a Reservation to an Itinerary.
-	 * @param reservation Smart pointer to a Reservation object to be cast.
-	 * @return Smart pointer to an Itinerary object.
-	 */
-	Itinerary_ptr dynamicCast(Reservation_ptr &&reservation);
+	/// Saved itineraries; copies of the user share them.
+	std::vector<SharedItinerary> Itineraries;
+	/// Cost of every saved itinerary, kept up to date as they are added or removed.
+	Money total_cost;
 
 public:
 	/**
@@ -51,6 +47,7 @@ public:
 
 	/**
 	 * @brief Copy constructor for User.
+	 * @details Shares the other user's itineraries; nothing is cloned.
 	 * @param other Another User object to copy from.
 	 */
 	User(const User &other);
@@ -100,20 +97,29 @@ public:
 
 	/**
 	 * @brief Displays the user's itineraries.
+	 * @details The total line reads the running total.
 	 */
 	void viewMyItineraries() const;
 
 	/**
 	 * @brief Adds an itinerary to the user's collection.
+	 * @details Saves a copy sharing the itinerary's reservations, so the builder can go on
+	 *          with the original.
 	 * @param it Smart pointer to the Itinerary object to add.
 	 */
 	void addItinerary(const Itinerary_ptr &it);
 
 	/**
 	 * @brief Removes an itinerary from the user's collection.
-	 * @param it Smart pointer to the Itinerary object to remove.
+	 * @param it Smart pointer to the Itinerary object to remove; reset once removed.
+	 */
+	void removeItinerary(SharedItinerary &it);
+
+	/**
+	 * @brief Gets the total cost of the user's itineraries.
+	 * @return The sum of their costs.
 	 */
-	void removeItinerary(Itinerary_ptr &it);
+	Money getTotalCost() const;
 };
 
 /**
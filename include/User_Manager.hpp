@@ -113,7 +113,7 @@ public:
 	 * @brief Removes an itinerary from the currently logged-in user's list.
 	 * @param it Smart pointer to the Itinerary object to remove.
 	 */
-	void removeItineraryFromUser(Itinerary_ptr &it);
+	void removeItineraryFromUser(SharedItinerary &it);
 };
 
 /**
@@ -0,0 +1,127 @@
+/**
+ * @file Adapter_Registry.cpp
+ * @brief Implements the airline and hotel adapter registry
+ * @details Provides:
+ *          - Brand registration by ProviderId
+ *          - Providers file parsing and enabling
+ *          - Lazy adapter construction and booking dispatch
+ *          - Search counters of the enabled brands
+ *
+ * @author Abdallah Salem
+ */
+#include "../include/Adapter_Registry.hpp"
+#include "../include/Inventory_Index.hpp"
+#include <fstream>
+#include <sstream>
+#include <iostream>
+
+AdapterRegistry& AdapterRegistry::instance() {
+	static AdapterRegistry registry;
+	return registry;
+}
+
+bool AdapterRegistry::addFlightProvider(ProviderId id,
+		FlightProvider provider) {
+	if (flights.size() <= id)
+		flights.resize(id + 1);
+	flights[id] = std::move(provider);
+	return true;
+}
+
+bool AdapterRegistry::addHotelProvider(ProviderId id, HotelProvider provider) {
+	if (hotels.size() <= id)
+		hotels.resize(id + 1);
+	hotels[id] = std::move(provider);
+	return true;
+}
+
+void AdapterRegistry::configureOnce() {
+	std::call_once(configured, [this] {
+		configure(inventoryPath("providers.conf"));
+	});
+}
+
+void AdapterRegistry::configure(const std::string &path) {
+	enabled_flights.clear();
+	enabled_hotels.clear();
+	std::ifstream file(path);
+	if (!file) {
+		//no configuration, every registered brand is enabled.
+		for (std::size_t id = 0; id < flights.size(); id++)
+			if (flights[id].adapter)
+				enabled_flights.push_back((ProviderId) id);
+		for (std::size_t id = 0; id < hotels.size(); id++)
+			if (hotels[id].adapter)
+				enabled_hotels.push_back((ProviderId) id);
+		return;
+	}
+	std::string line;
+	while (std::getline(file, line)) {
+		std::istringstream fields(line);
+		std::string kind, name;
+		if (!(fields >> kind) || kind[0] == '#')
+			continue;
+		fields >> name;
+		ProviderId id = ProviderRegistry::instance().intern(name);
+		if (kind == "flight" && id < flights.size() && flights[id].adapter)
+			enabled_flights.push_back(id);
+		else if (kind == "hotel" && id < hotels.size() && hotels[id].adapter)
+			enabled_hotels.push_back(id);
+		else
+			std::cerr << path << ": unknown provider '" << kind << " " << name
+					<< "' ignored\n";
+	}
+}
+
+std::vector<FlightReservation_ptr> AdapterRegistry::makeFlightAdapters() {
+	configureOnce();
+	std::vector<FlightReservation_ptr> adapters;
+	for (ProviderId id : enabled_flights)
+		adapters.push_back(flights[id].adapter());
+	return adapters;
+}
+
+std::vector<HotelReservation_ptr> AdapterRegistry::makeHotelAdapters() {
+	configureOnce();
+	std::vector<HotelReservation_ptr> adapters;
+	for (ProviderId id : enabled_hotels)
+		adapters.push_back(hotels[id].adapter());
+	return adapters;
+}
+
+void AdapterRegistry::appendInventoryLegs(std::vector<FlightLeg> &legs) {
+	configureOnce();
+	for (ProviderId id : enabled_flights)
+		if (flights[id].inventory)
+			flights[id].inventory(legs);
+}
+
+std::vector<SearchStats> AdapterRegistry::searchStats() {
+	configureOnce();
+	std::vector<SearchStats> stats;
+	for (ProviderId id : enabled_flights)
+		if (flights[id].stats)
+			stats.push_back(flights[id].stats());
+	for (ProviderId id : enabled_hotels)
+		if (hotels[id].stats)
+			stats.push_back(hotels[id].stats());
+	return stats;
+}
+
+bool AdapterRegistry::isFlightProvider(ProviderId id) const {
+	return id < flights.size() && flights[id].book;
+}
+
+Reservation_ptr AdapterRegistry::bookFlight(ProviderId id,
+		PassengerQuery passenger_info, FlightInfo_ptr &&flight) const {
+	if (!isFlightProvider(id))
+		return nullptr;
+	return flights[id].book(std::move(passenger_info), std::move(flight));
+}
+
+Reservation_ptr AdapterRegistry::bookHotel(ProviderId id,
+		CustomerQuery customer_info, RoomInfo_ptr &&room) const {
+	if (id >= hotels.size() || !hotels[id].book)
+		return nullptr;
+	return hotels[id].book(std::move(customer_info), std::move(room));
+}
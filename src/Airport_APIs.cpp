@@ -5,14 +5,31 @@
  *          - Customer info and flight classes
  *          - API interaction methods
  *          - Flight retrieval and reservation handling
+ *          - Switching to the provider simulator when it is active
+ *          - Coroutine variants that wait on the simulator without holding a thread
  *
  * @author Abdallah Salem
  */
 
 #include"../include/Airport_APIs.hpp"
+#include"../include/Provider_Simulator.hpp"
+
+/**
+ * @brief Converts simulated flights into an airline's flight records.
+ */
+template<typename Flight>
+static std::vector<Flight> toFlights(
+		const std::vector<SimulatedFlight> &simulated) {
+	std::vector<Flight> flights;
+	flights.reserve(simulated.size());
+	for (const SimulatedFlight &flight : simulated)
+		flights.push_back(Flight { flight.price, flight.departure,
+				flight.arrival });
+	return flights;
+}
 
 AirCanadaCustomerInfo::AirCanadaCustomerInfo(std::string from, std::string to,
-		std::string date_time_from, std::string date_time_to, int adults,
+		DateTime date_time_from, DateTime date_time_to, int adults,
 		int children, int infants) :
 		from(from), to(to), date_time_from(date_time_from), date_time_to(
 				date_time_to), adults(adults), children(children), infants(
@@ -20,7 +37,7 @@ AirCanadaCustomerInfo::AirCanadaCustomerInfo(std::string from, std::string to,
 
 }
 
-AirCanadaFlight::AirCanadaFlight(double price, std::string from, std::string to) :
+AirCanadaFlight::AirCanadaFlight(Money price, DateTime from, DateTime to) :
 		price(price), date_time_from(from), date_time_to(to) {
 }
 
@@ -28,35 +45,71 @@ void AirCanadaOnlineAPI::setCustomerInfo(const AirCanadaCustomerInfo &info) {
 	//API operations to set information
 }
 
-std::vector<AirCanadaFlight> AirCanadaOnlineAPI::getFlights() {
-	//dummy data for available flights returned from API
+std::vector<AirCanadaFlight> AirCanadaOnlineAPI::getFlights(
+		const AirCanadaCustomerInfo &info) {
+	ProviderSimulator &simulator = ProviderSimulator::instance();
+	if (simulator.isActive())
+		return toFlights<AirCanadaFlight>(
+				simulator.searchFlights("Canada", info.from, info.to,
+						info.date_time_from));
 	std::vector < AirCanadaFlight > flights;
-	flights.push_back(AirCanadaFlight { 200, "25-01-2022", "10-02-2022" });
-	flights.push_back(AirCanadaFlight { 250, "29-01-2022", "10-02-2022" });
+	//dummy data for available flights returned from API
+	flights.push_back(AirCanadaFlight { Money(20000), DateTime::parse("25-01-2022"),
+			DateTime::parse("10-02-2022") });
+	flights.push_back(AirCanadaFlight { Money(25000), DateTime::parse("29-01-2022"),
+			DateTime::parse("10-02-2022") });
 	return flights;
 }
 
 bool AirCanadaOnlineAPI::reserveFlight(const AirCanadaFlight &flight,
 		const AirCanadaCustomerInfo &info) {
+	if (ProviderSimulator::instance().isActive())
+		return ProviderSimulator::instance().call("Canada");
 	//API makes the reservation and return true.
 	return true;
 }
 
 bool AirCanadaOnlineAPI::cancelReserveFlight(const AirCanadaFlight &flight,
 		const AirCanadaCustomerInfo &info) {
+	if (ProviderSimulator::instance().isActive())
+		return ProviderSimulator::instance().call("Canada");
 	//API cancel the reservation and return true.
 	return false;
 }
 
+Task<std::vector<AirCanadaFlight>> AirCanadaOnlineAPI::getFlightsAsync(
+		EventLoop &loop, AirCanadaCustomerInfo info) {
+	ProviderSimulator &simulator = ProviderSimulator::instance();
+	if (!simulator.isActive())
+		co_return getFlights(info);
+	co_return toFlights<AirCanadaFlight>(
+			co_await simulator.searchFlightsAsync(loop, "Canada", info.from,
+					info.to, info.date_time_from));
+}
+
+Task<bool> AirCanadaOnlineAPI::reserveFlightAsync(EventLoop &loop,
+		AirCanadaFlight flight, AirCanadaCustomerInfo info) {
+	if (!ProviderSimulator::instance().isActive())
+		co_return reserveFlight(flight, info);
+	co_return co_await ProviderSimulator::instance().callAsync(loop, "Canada");
+}
+
+Task<bool> AirCanadaOnlineAPI::cancelReserveFlightAsync(EventLoop &loop,
+		AirCanadaFlight flight, AirCanadaCustomerInfo info) {
+	if (!ProviderSimulator::instance().isActive())
+		co_return cancelReserveFlight(flight, info);
+	co_return co_await ProviderSimulator::instance().callAsync(loop, "Canada");
+}
+
 TurkishCustomerInfo::TurkishCustomerInfo(std::string from, std::string to,
-		std::string datetime_from, std::string datetime_to, int adults,
+		DateTime datetime_from, DateTime datetime_to, int adults,
 		int children, int infants) :
 		from(from), to(to), datetime_from(datetime_from), datetime_to(
 				datetime_to), adults(adults), children(children), infants(
 				infants) {
 }
 
-TurkishFlight::TurkishFlight(double cost, std::string from, std::string to) :
+TurkishFlight::TurkishFlight(Money cost, DateTime from, DateTime to) :
 		cost(cost), datetime_from(from), datetime_to(to) {
 
 }
@@ -70,22 +123,58 @@ void TurkishAirlineOnlineAPI::setPassengerInfo(
 
 }
 
-std::vector<TurkishFlight> TurkishAirlineOnlineAPI::getAvailableFlights() {
-	//dummy data returned form API.
+std::vector<TurkishFlight> TurkishAirlineOnlineAPI::getAvailableFlights(
+		const TurkishCustomerInfo &info) {
+	ProviderSimulator &simulator = ProviderSimulator::instance();
+	if (simulator.isActive())
+		return toFlights<TurkishFlight>(
+				simulator.searchFlights("Turkish", info.from, info.to,
+						info.datetime_from));
 	std::vector < TurkishFlight > flights;
-	flights.push_back(TurkishFlight { 200, "25-01-2022", "10-02-2022" });
-	flights.push_back(TurkishFlight { 250, "29-01-2022", "10-02-2022" });
+	//dummy data returned form API.
+	flights.push_back(TurkishFlight { Money(20000), DateTime::parse("25-01-2022"),
+			DateTime::parse("10-02-2022") });
+	flights.push_back(TurkishFlight { Money(25000), DateTime::parse("29-01-2022"),
+			DateTime::parse("10-02-2022") });
 	return flights;
 }
 
 bool TurkishAirlineOnlineAPI::reserveFlight(const TurkishCustomerInfo &info,
 		const TurkishFlight &flight) {
+	if (ProviderSimulator::instance().isActive())
+		return ProviderSimulator::instance().call("Turkish");
 	//API makes the reservation and return true.
 	return true;
 }
 
 bool TurkishAirlineOnlineAPI::cancelReservedFlight(
 		const TurkishCustomerInfo &info, const TurkishFlight &flight) {
+	if (ProviderSimulator::instance().isActive())
+		return ProviderSimulator::instance().call("Turkish");
 	//API cancels the reservation and return true.
 	return false;
 }
+
+Task<std::vector<TurkishFlight>> TurkishAirlineOnlineAPI::getAvailableFlightsAsync(
+		EventLoop &loop, TurkishCustomerInfo info) {
+	ProviderSimulator &simulator = ProviderSimulator::instance();
+	if (!simulator.isActive())
+		co_return getAvailableFlights(info);
+	co_return toFlights<TurkishFlight>(
+			co_await simulator.searchFlightsAsync(loop, "Turkish", info.from,
+					info.to, info.datetime_from));
+}
+
+Task<bool> TurkishAirlineOnlineAPI::reserveFlightAsync(EventLoop &loop,
+		TurkishCustomerInfo info, TurkishFlight flight) {
+	if (!ProviderSimulator::instance().isActive())
+		co_return reserveFlight(info, flight);
+	co_return co_await ProviderSimulator::instance().callAsync(loop, "Turkish");
+}
+
+Task<bool> TurkishAirlineOnlineAPI::cancelReservedFlightAsync(EventLoop &loop,
+		TurkishCustomerInfo info, TurkishFlight flight) {
+	if (!ProviderSimulator::instance().isActive())
+		co_return cancelReservedFlight(info, flight);
+	co_return co_await ProviderSimulator::instance().callAsync(loop, "Turkish");
+}
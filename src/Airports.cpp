@@ -5,235 +5,472 @@
  *          - CanadaFlightReservation: Adapter for Air Canada flights
  *          - TurkishFlightReservation: Adapter for Turkish Airlines flights
  *          - Handles data conversion between system and airline APIs
+ *          - Searches each airline through a ProviderSearch (cache per normalized
+ *            request, shared, hedged, limited and measured API calls)
+ *          - Indexes local airline inventory by route, or maps its binary inventory file
+ *          - Coroutine search and booking on an EventLoop
+ *          - Registers both airlines with the adapter registry
  *
  * @author Abdallah Salem
  */
 
 #include"../include/Airports.hpp"
+#include"../include/Inventory_Index.hpp"
+#include"../include/Mapped_Inventory.hpp"
+#include"../include/Adapter_Registry.hpp"
+#include"../include/Provider_Simulator.hpp"
+#include"../include/Provider_Search.hpp"
+
+/**
+ * @brief Builds the cache key of a flight search.
+ * @return Key made of the normalized route, dates and passenger mix.
+ */
+static std::string flightSearchKey(const PassengerInfo &query) {
+	return normalizeSearchText(query.from) + "|" + normalizeSearchText(query.to)
+			+ "|" + std::to_string(DateTime(query.from_date).minuteNumber()) + "|"
+			+ std::to_string(DateTime(query.to_date).minuteNumber()) + "|"
+			+ std::to_string(query.adults) + "/" + std::to_string(query.children)
+			+ "/" + std::to_string(query.infants);
+}
+
+/**
+ * @brief Puts a passenger request in Air Canada's format, right before calling it.
+ */
+static AirCanadaCustomerInfo canadaRequest(const PassengerInfo &query) {
+	return AirCanadaCustomerInfo(query.from, query.to, query.from_date,
+			query.to_date, query.adults, query.children, query.infants);
+}
+
+/**
+ * @brief Puts a passenger request in Turkish Airlines' format, right before calling it.
+ */
+static TurkishCustomerInfo turkishRequest(const PassengerInfo &query) {
+	return TurkishCustomerInfo(query.from, query.to, query.from_date,
+			query.to_date, query.adults, query.children, query.infants);
+}
+
+/**
+ * @brief Request of adapters not given one yet.
+ */
+static const PassengerQuery& noPassengers() {
+	static const PassengerQuery empty = std::make_shared<const PassengerInfo>();
+	return empty;
+}
+
+/**
+ * @brief Loads a flight inventory, mapping its binary file when there is one.
+ * @details "<name>.inv" is mapped and searched in place. Otherwise "<name>.csv" is read
+ *          into a route index; its lines are "from, to, price, departure, arrival", dates as
+ *          dd-mm-yyyy or dd-mm-yyyy hh:mm. With neither file the inventory is empty.
+ * @param name Inventory file name without its extension.
+ * @return The inventory.
+ */
+template<typename Flight>
+static ProviderInventory<Flight> loadFlightInventory(const std::string &name) {
+	auto mapped = std::make_unique<MappedInventory>(inventoryPath(name + ".inv"));
+	if (mapped->isOpen())
+		return ProviderInventory<Flight>(std::move(mapped),
+				[](const MappedInventory&, const InventoryRecord &record) {
+					return Flight { Money(record.price), DateTime(record.from), DateTime(
+							record.to) };
+				});
+	InventoryIndex<Flight> index;
+	readInventoryFile(inventoryPath(name + ".csv"),
+			[&](const std::vector<std::string> &fields) {
+				Money price;
+				if (fields.size() != 5 || !parseInventoryNumber(fields[2], price))
+					return false;
+				DateTime departure = DateTime::parse(fields[3]);
+				DateTime arrival = DateTime::parse(fields[4]);
+				if (!departure.isValid() || !arrival.isValid())
+					return false;
+				index.add(fields[0], fields[1], Flight { price, departure, arrival });
+				return true;
+			});
+	return ProviderInventory<Flight>(std::move(index));
+}
+
+/**
+ * @brief Air Canada inventory by route, loaded on first use from air_canada_flights.inv
+ *        or air_canada_flights.csv.
+ */
+static const ProviderInventory<AirCanadaFlight>& canadaInventory() {
+	static const ProviderInventory<AirCanadaFlight> inventory =
+			loadFlightInventory<AirCanadaFlight>("air_canada_flights");
+	return inventory;
+}
+
+/**
+ * @brief Turkish Airlines inventory by route, loaded on first use from turkish_flights.inv
+ *        or turkish_flights.csv.
+ */
+static const ProviderInventory<TurkishFlight>& turkishInventory() {
+	static const ProviderInventory<TurkishFlight> inventory =
+			loadFlightInventory<TurkishFlight>("turkish_flights");
+	return inventory;
+}
+
+/**
+ * @brief Limits the Air Canada calls in flight and stops calling it while it keeps failing.
+ */
+static ProviderLimiter& canadaLimiter() {
+	return ProviderLimiter::forProvider("Canada");
+}
+
+/**
+ * @brief Latency and outcome of every Air Canada API call.
+ */
+static BookingCallMetrics& canadaMetrics() {
+	static BookingCallMetrics metrics("Canada");
+	return metrics;
+}
+
+/**
+ * @brief Limits the Turkish Airlines calls in flight and stops calling it while it keeps
+ *        failing.
+ */
+static ProviderLimiter& turkishLimiter() {
+	return ProviderLimiter::forProvider("Turkish");
+}
+
+/**
+ * @brief Latency and outcome of every Turkish Airlines API call.
+ */
+static BookingCallMetrics& turkishMetrics() {
+	static BookingCallMetrics metrics("Turkish");
+	return metrics;
+}
+
+/**
+ * @brief Answers a flight search from an airline's route index.
+ * @return The flights on the route, nullopt when the airline has no inventory.
+ */
+template<typename Flight>
+static std::optional<std::vector<Flight>> stockedFlights(
+		const ProviderInventory<Flight> &inventory, const PassengerInfo &query) {
+	if (inventory.empty())
+		return std::nullopt;
+	return inventory.find(query.from, query.to);
+}
+
+/**
+ * @brief Air Canada searches, answered from cache, the route index in
+ *        air_canada_flights.inv or .csv, or AirCanadaOnlineAPI::getFlights.
+ */
+static ProviderSearch<AirCanadaFlight, PassengerInfo, AirCanadaCustomerInfo>& canadaSearch() {
+	static ProviderSearch<AirCanadaFlight, PassengerInfo, AirCanadaCustomerInfo> search(
+			"Canada", canadaMetrics().search, 1024, std::chrono::seconds(60), {
+					flightSearchKey, canadaRequest, [](const PassengerInfo &query) {
+						return stockedFlights(canadaInventory(), query);
+					}, AirCanadaOnlineAPI::getFlights,
+					AirCanadaOnlineAPI::getFlightsAsync });
+	return search;
+}
+
+/**
+ * @brief Turkish Airlines searches, answered from cache, the route index in
+ *        turkish_flights.inv or .csv, or TurkishAirlineOnlineAPI::getAvailableFlights.
+ */
+static ProviderSearch<TurkishFlight, PassengerInfo, TurkishCustomerInfo>& turkishSearch() {
+	static ProviderSearch<TurkishFlight, PassengerInfo, TurkishCustomerInfo> search(
+			"Turkish", turkishMetrics().search, 1024, std::chrono::seconds(30), {
+					flightSearchKey, turkishRequest, [](const PassengerInfo &query) {
+						return stockedFlights(turkishInventory(), query);
+					}, TurkishAirlineOnlineAPI::getAvailableFlights,
+					TurkishAirlineOnlineAPI::getAvailableFlightsAsync });
+	return search;
+}
 
 CanadaFlightReservation::CanadaFlightReservation() :
-		canada_customer_info(std::make_unique<AirCanadaCustomerInfo>()), canada_chosen_flight(
-				std::make_unique<AirCanadaFlight>()) {
+		passenger_query(noPassengers()) {
 
 }
 
 CanadaFlightReservation::CanadaFlightReservation(
-		PassengerInfo_ptr &&customer_info, FlightInfo_ptr &&chosen_flight) :
+		PassengerQuery customer_info, FlightInfo_ptr &&chosen_flight) :
 		CanadaFlightReservation() {
 	CanadaFlightReservation::setCustomerInfo(std::move(customer_info));
 	CanadaFlightReservation::setChosenFlight(std::move(chosen_flight));
 }
 
+//the request is shared and read-only, so copies share it too.
 CanadaFlightReservation::CanadaFlightReservation(
-		const CanadaFlightReservation &other) :
-		CanadaFlightReservation() {
-	//handling ownership of unique pointers.
-	*(canada_customer_info) = *(other.canada_customer_info);
-	*(canada_chosen_flight) = *(other.canada_chosen_flight);
-}
+		const CanadaFlightReservation &other) = default;
 
 CanadaFlightReservation::CanadaFlightReservation(
-		CanadaFlightReservation &&other) :
-		canada_customer_info(std::move(canada_customer_info)), canada_chosen_flight(
-				std::move(canada_chosen_flight)) {
-
-}
+		CanadaFlightReservation &&other) = default;
 
 CanadaFlightReservation& CanadaFlightReservation::operator=(
-		const CanadaFlightReservation &other) {
-	if (this != &other) {
-		//handling ownership of unique pointers.
-		*(canada_customer_info) = *(other.canada_customer_info);
-		*(canada_chosen_flight) = *(other.canada_chosen_flight);
-	}
-	return *this;
-}
+		const CanadaFlightReservation &other) = default;
 
 CanadaFlightReservation& CanadaFlightReservation::operator=(
-		CanadaFlightReservation &&other) {
-	if (this != &other) {
-		//move ownership semantically
-		canada_customer_info = std::move(canada_customer_info);
-		canada_chosen_flight = std::move(canada_chosen_flight);
-	}
-	return *this;
-}
+		CanadaFlightReservation &&other) = default;
 
-void CanadaFlightReservation::setCustomerInfo(PassengerInfo_ptr &&info) {
-	canada_customer_info->from = info->from;
-	canada_customer_info->to = info->to;
-	canada_customer_info->date_time_from = info->from_date;
-	canada_customer_info->date_time_to = info->to_date;
-	canada_customer_info->adults = info->adults;
-	canada_customer_info->children = info->children;
-	canada_customer_info->infants = info->infants;
+void CanadaFlightReservation::setCustomerInfo(PassengerQuery info) {
+	passenger_query = std::move(info);
 }
 
 void CanadaFlightReservation::setChosenFlight(FlightInfo_ptr &&info) {
-	canada_chosen_flight->date_time_from = info->from_date;
-	canada_chosen_flight->date_time_to = info->to_date;
-	canada_chosen_flight->price = info->price;
+	canada_chosen_flight.date_time_from = info->from_date;
+	canada_chosen_flight.date_time_to = info->to_date;
+	canada_chosen_flight.price = info->price;
 }
 
 void CanadaFlightReservation::getAvailableFlights(
 		std::vector<FoundFlightInfo> &&flights) {
-	//get information from API
-	std::vector < AirCanadaFlight > available_flights =
-			AirCanadaOnlineAPI::getFlights();
+	std::vector < AirCanadaFlight > available_flights = canadaSearch().find(
+			*passenger_query);
 	//Adding brand name to information
 	for (int i = 0; i < (int) available_flights.size(); i++)
 		flights.push_back(
-				{ "Canada", available_flights[i].price,
+				{ CanadaFlightReservation::providerId(),
+						available_flights[i].price,
 						available_flights[i].date_time_from,
 						available_flights[i].date_time_to });
 }
 
+void CanadaFlightReservation::appendAvailableFlights(FlightColumns &columns) {
+	std::vector < AirCanadaFlight > available_flights = canadaSearch().find(
+			*passenger_query);
+	columns.reserve(columns.size() + available_flights.size());
+	for (const AirCanadaFlight &flight : available_flights)
+		columns.append(CanadaFlightReservation::providerId(), flight.price,
+				flight.date_time_from, flight.date_time_to);
+}
+
+Task<std::vector<FoundFlightInfo>> CanadaFlightReservation::getAvailableFlightsAsync(
+		EventLoop &loop) {
+	Task<std::vector<AirCanadaFlight>> search = canadaSearch().findAsync(loop,
+			passenger_query);
+	std::vector < AirCanadaFlight > available_flights = co_await search;
+	std::vector<FoundFlightInfo> flights;
+	flights.reserve(available_flights.size());
+	for (const AirCanadaFlight &flight : available_flights)
+		flights.push_back( { CanadaFlightReservation::providerId(), flight.price,
+				flight.date_time_from, flight.date_time_to });
+	co_return flights;
+}
+
 void CanadaFlightReservation::getDetails(std::ostream &&get) const {
 	//collect data in one string
 	get << "Airline Reservation/ AirCanada Airline: \n" << "From: "
-			<< canada_customer_info->from << "  on: "
-			<< canada_customer_info->date_time_from << "  To: "
-			<< canada_customer_info->to << "  on: "
-			<< canada_customer_info->date_time_to << "\n" << "\t\tAdults: "
-			<< canada_customer_info->adults << "  -  Children: "
-			<< canada_customer_info->children << "  -  Infants: "
-			<< canada_customer_info->infants << "\n" << "\t\tFlight Cost: "
+			<< passenger_query->from << "  on: "
+			<< passenger_query->from_date << "  To: "
+			<< passenger_query->to << "  on: "
+			<< passenger_query->to_date << "\n" << "\t\tAdults: "
+			<< passenger_query->adults << "  -  Children: "
+			<< passenger_query->children << "  -  Infants: "
+			<< passenger_query->infants << "\n" << "\t\tFlight Cost: "
 			<< CanadaFlightReservation::getCost();
 }
+ProviderId CanadaFlightReservation::providerId() {
+	static const ProviderId id = ProviderRegistry::instance().intern("Canada");
+	return id;
+}
+
+SearchStats CanadaFlightReservation::searchStats() {
+	return canadaSearch().stats();
+}
+
+void CanadaFlightReservation::appendInventoryLegs(std::vector<FlightLeg> &legs) {
+	canadaInventory().forEach(
+			[&legs](const std::string &from, const std::string &to,
+					const AirCanadaFlight &flight) {
+				legs.push_back( { from, to, CanadaFlightReservation::providerId(),
+						flight.price, flight.date_time_from, flight.date_time_to });
+			});
+}
+
 Reservation_ptr CanadaFlightReservation::clone() const {
 	return std::make_unique < CanadaFlightReservation > (*this);
 }
 
-double CanadaFlightReservation::getCost() const {
-	return canada_chosen_flight->price
-			* (canada_customer_info->adults + canada_customer_info->children
-					+ canada_customer_info->infants);
+Money CanadaFlightReservation::getCost() const {
+	return canada_chosen_flight.price
+			* (passenger_query->adults + passenger_query->children
+					+ passenger_query->infants);
 }
 
-bool CanadaFlightReservation::makeReservation() {
+Task<bool> CanadaFlightReservation::makeReservationAsync(EventLoop &loop) {
 	//calling API
-	return AirCanadaOnlineAPI::reserveFlight(*canada_chosen_flight,
-			*canada_customer_info);
+	return canadaLimiter().callAsync<bool>(loop, [this, &loop] {
+		return canadaMetrics().reserve.measureAsync<bool>([this, &loop] {
+			return AirCanadaOnlineAPI::reserveFlightAsync(loop, canada_chosen_flight,
+					canadaRequest(*passenger_query));
+		});
+	}, [] {
+		return false;
+	});
 }
 
-bool CanadaFlightReservation::cancelReservation() {
+Task<bool> CanadaFlightReservation::cancelReservationAsync(EventLoop &loop) {
 	//Calling API
-	return AirCanadaOnlineAPI::cancelReserveFlight(*canada_chosen_flight,
-			*canada_customer_info);
+	return canadaLimiter().callAsync<bool>(loop, [this, &loop] {
+		return canadaMetrics().cancel.measureAsync<bool>([this, &loop] {
+			return AirCanadaOnlineAPI::cancelReserveFlightAsync(loop,
+					canada_chosen_flight, canadaRequest(*passenger_query));
+		});
+	}, [] {
+		return false;
+	});
 }
 
 TurkishFlightReservation::TurkishFlightReservation() :
-		turkish_customer_info(std::make_unique<TurkishCustomerInfo>()), turkish_chosen_flight(
-				std::make_unique<TurkishFlight>()) {
+		passenger_query(noPassengers()) {
 
 }
 
 TurkishFlightReservation::TurkishFlightReservation(
-		PassengerInfo_ptr &&customer_info, FlightInfo_ptr &&chosen_flight) :
+		PassengerQuery customer_info, FlightInfo_ptr &&chosen_flight) :
 		TurkishFlightReservation() {
 	TurkishFlightReservation::setCustomerInfo(std::move(customer_info));
 	TurkishFlightReservation::setChosenFlight(std::move(chosen_flight));
 }
 
+//the request is shared and read-only, so copies share it too.
 TurkishFlightReservation::TurkishFlightReservation(
-		const TurkishFlightReservation &other) :
-		TurkishFlightReservation() {
-	//handling ownership of unique pointers.
-	if (other.turkish_customer_info)
-		*(turkish_customer_info) = *(other.turkish_customer_info);
-	if (other.turkish_chosen_flight)
-		*(turkish_chosen_flight) = *(other.turkish_chosen_flight);
-}
+		const TurkishFlightReservation &other) = default;
 
 TurkishFlightReservation::TurkishFlightReservation(
-		TurkishFlightReservation &&other) :
-		turkish_customer_info(std::move(turkish_customer_info)), turkish_chosen_flight(
-				std::move(turkish_chosen_flight)) {
+		TurkishFlightReservation &&other) = default;
 
-}
-
-TurkishFlightReservation& TurkishFlightReservation::operator =(
-		const TurkishFlightReservation &other) {
-	if (this != &other) {
-		//handling ownership of unique pointers.
-		if (other.turkish_customer_info)
-			*(turkish_customer_info) = *(other.turkish_customer_info);
-		if (other.turkish_chosen_flight)
-			*(turkish_chosen_flight) = *(other.turkish_chosen_flight);
-	}
-	return *this;
-}
+TurkishFlightReservation& TurkishFlightReservation::operator=(
+		const TurkishFlightReservation &other) = default;
 
-TurkishFlightReservation& TurkishFlightReservation::operator =(
-		TurkishFlightReservation &&other) {
-	if (this != &other) {
-		turkish_customer_info = std::move(other.turkish_customer_info);
-		turkish_chosen_flight = std::move(other.turkish_chosen_flight);
-	}
-	return *this;
-}
+TurkishFlightReservation& TurkishFlightReservation::operator=(
+		TurkishFlightReservation &&other) = default;
 
-void TurkishFlightReservation::setCustomerInfo(PassengerInfo_ptr &&info) {
-	turkish_customer_info->from = info->from;
-	turkish_customer_info->to = info->to;
-	turkish_customer_info->datetime_from = info->from_date;
-	turkish_customer_info->datetime_to = info->to_date;
-	turkish_customer_info->adults = info->adults;
-	turkish_customer_info->children = info->children;
-	turkish_customer_info->infants = info->infants;
+void TurkishFlightReservation::setCustomerInfo(PassengerQuery info) {
+	passenger_query = std::move(info);
 }
 
 void TurkishFlightReservation::setChosenFlight(FlightInfo_ptr &&info) {
-	turkish_chosen_flight->datetime_from = info->from_date;
-	turkish_chosen_flight->datetime_to = info->to_date;
-	turkish_chosen_flight->cost = info->price;
+	turkish_chosen_flight.datetime_from = info->from_date;
+	turkish_chosen_flight.datetime_to = info->to_date;
+	turkish_chosen_flight.cost = info->price;
 }
 
 void TurkishFlightReservation::getAvailableFlights(
 		std::vector<FoundFlightInfo> &&flights) {
-	//get information from API
-	std::vector < TurkishFlight > available_flights =
-			TurkishAirlineOnlineAPI::getAvailableFlights();
+	std::vector < TurkishFlight > available_flights = turkishSearch().find(
+			*passenger_query);
 	//add brand name to information
 	for (int i = 0; i < (int) available_flights.size(); i++)
 		flights.push_back(
-				{ "Turkish", available_flights[i].cost,
+				{ TurkishFlightReservation::providerId(),
+						available_flights[i].cost,
 						available_flights[i].datetime_from,
 						available_flights[i].datetime_to });
 }
 
+void TurkishFlightReservation::appendAvailableFlights(FlightColumns &columns) {
+	std::vector < TurkishFlight > available_flights = turkishSearch().find(
+			*passenger_query);
+	columns.reserve(columns.size() + available_flights.size());
+	for (const TurkishFlight &flight : available_flights)
+		columns.append(TurkishFlightReservation::providerId(), flight.cost,
+				flight.datetime_from, flight.datetime_to);
+}
+
+Task<std::vector<FoundFlightInfo>> TurkishFlightReservation::getAvailableFlightsAsync(
+		EventLoop &loop) {
+	Task<std::vector<TurkishFlight>> search = turkishSearch().findAsync(loop,
+			passenger_query);
+	std::vector < TurkishFlight > available_flights = co_await search;
+	std::vector<FoundFlightInfo> flights;
+	flights.reserve(available_flights.size());
+	for (const TurkishFlight &flight : available_flights)
+		flights.push_back( { TurkishFlightReservation::providerId(), flight.cost,
+				flight.datetime_from, flight.datetime_to });
+	co_return flights;
+}
+
 void TurkishFlightReservation::getDetails(std::ostream &&get) const {
 	//collect data in one string.
 	get << "Airline Reservation/ Turkish Airline: \n" << "From: "
-			<< turkish_customer_info->from << "  on: "
-			<< turkish_customer_info->datetime_from << "  To: "
-			<< turkish_customer_info->to << "  on: "
-			<< turkish_customer_info->datetime_to << "\n" << "\t\tAdults: "
-			<< turkish_customer_info->adults << "  -  Children: "
-			<< turkish_customer_info->children << "  -  "
-			<< turkish_customer_info->infants << "\n" << "\t\tFlight Cost: "
+			<< passenger_query->from << "  on: "
+			<< passenger_query->from_date << "  To: "
+			<< passenger_query->to << "  on: "
+			<< passenger_query->to_date << "\n" << "\t\tAdults: "
+			<< passenger_query->adults << "  -  Children: "
+			<< passenger_query->children << "  -  "
+			<< passenger_query->infants << "\n" << "\t\tFlight Cost: "
 			<< TurkishFlightReservation::getCost();
 }
 
-double TurkishFlightReservation::getCost() const {
-	return turkish_chosen_flight->cost
-			* (turkish_customer_info->adults + turkish_customer_info->children
-					+ turkish_customer_info->infants);
+Money TurkishFlightReservation::getCost() const {
+	return turkish_chosen_flight.cost
+			* (passenger_query->adults + passenger_query->children
+					+ passenger_query->infants);
+}
+
+ProviderId TurkishFlightReservation::providerId() {
+	static const ProviderId id = ProviderRegistry::instance().intern("Turkish");
+	return id;
+}
+
+SearchStats TurkishFlightReservation::searchStats() {
+	return turkishSearch().stats();
+}
+
+void TurkishFlightReservation::appendInventoryLegs(std::vector<FlightLeg> &legs) {
+	turkishInventory().forEach(
+			[&legs](const std::string &from, const std::string &to,
+					const TurkishFlight &flight) {
+				legs.push_back( { from, to, TurkishFlightReservation::providerId(),
+						flight.cost, flight.datetime_from, flight.datetime_to });
+			});
 }
 
 Reservation_ptr TurkishFlightReservation::clone() const {
 	return std::make_unique < TurkishFlightReservation > (*this);
 }
 
-bool TurkishFlightReservation::makeReservation() {
+Task<bool> TurkishFlightReservation::makeReservationAsync(EventLoop &loop) {
 	//calling API
-	return TurkishAirlineOnlineAPI::reserveFlight(*turkish_customer_info,
-			*turkish_chosen_flight);
+	return turkishLimiter().callAsync<bool>(loop, [this, &loop] {
+		return turkishMetrics().reserve.measureAsync<bool>([this, &loop] {
+			return TurkishAirlineOnlineAPI::reserveFlightAsync(loop,
+					turkishRequest(*passenger_query), turkish_chosen_flight);
+		});
+	}, [] {
+		return false;
+	});
 }
 
-bool TurkishFlightReservation::cancelReservation() {
+Task<bool> TurkishFlightReservation::cancelReservationAsync(EventLoop &loop) {
 	//calling API
-	return TurkishAirlineOnlineAPI::cancelReservedFlight(*turkish_customer_info,
-			*turkish_chosen_flight);
+	return turkishLimiter().callAsync<bool>(loop, [this, &loop] {
+		return turkishMetrics().cancel.measureAsync<bool>([this, &loop] {
+			return TurkishAirlineOnlineAPI::cancelReservedFlightAsync(loop,
+					turkishRequest(*passenger_query), turkish_chosen_flight);
+		});
+	}, [] {
+		return false;
+	});
 }
 
+//register both airlines; MakeReservation only knows them through the registry.
+static const bool canada_registered =
+		AdapterRegistry::instance().addFlightProvider(
+				CanadaFlightReservation::providerId(),
+				{ [] {
+					return std::make_unique<CanadaFlightReservation>();
+				}, [](PassengerQuery passenger_info,
+						FlightInfo_ptr &&flight) -> Reservation_ptr {
+					return std::make_unique<CanadaFlightReservation>(
+							std::move(passenger_info), std::move(flight));
+				}, CanadaFlightReservation::appendInventoryLegs,
+				CanadaFlightReservation::searchStats });
+
+static const bool turkish_registered =
+		AdapterRegistry::instance().addFlightProvider(
+				TurkishFlightReservation::providerId(),
+				{ [] {
+					return std::make_unique<TurkishFlightReservation>();
+				}, [](PassengerQuery passenger_info,
+						FlightInfo_ptr &&flight) -> Reservation_ptr {
+					return std::make_unique<TurkishFlightReservation>(
+							std::move(passenger_info), std::move(flight));
+				}, TurkishFlightReservation::appendInventoryLegs,
+				TurkishFlightReservation::searchStats });
@@ -0,0 +1,77 @@
+/**
+ * @file Async_Call.cpp
+ * @brief Implements the event loop behind asynchronous provider calls
+ * @details Provides:
+ *          - Loop thread start-up and shutdown
+ *          - Ready queue and timer dispatch
+ *
+ * @author Abdallah Salem
+ */
+#include "../include/Async_Call.hpp"
+#include <algorithm>
+
+EventLoop::EventLoop(std::size_t threads) {
+	if (threads == 0)
+		threads = 1;
+	for (std::size_t i = 0; i < threads; i++)
+		workers.emplace_back(&EventLoop::run, this);
+}
+
+EventLoop& EventLoop::instance() {
+	static EventLoop loop(
+			std::min<std::size_t>(4,
+					std::max(1u, std::thread::hardware_concurrency())));
+	return loop;
+}
+
+void EventLoop::run() {
+	std::unique_lock<std::mutex> guard(lock);
+	while (true) {
+		auto now = std::chrono::steady_clock::now();
+		while (!timers.empty() && timers.top().due <= now) {
+			ready.push_back(timers.top().waiting);
+			timers.pop();
+		}
+		if (!ready.empty()) {
+			std::coroutine_handle<> next = ready.front();
+			ready.pop_front();
+			guard.unlock();
+			next.resume();
+			guard.lock();
+			continue;
+		}
+		if (stopping)
+			return;
+		if (timers.empty())
+			wake.wait(guard);
+		else
+			wake.wait_until(guard, timers.top().due);
+	}
+}
+
+void EventLoop::post(std::coroutine_handle<> waiting) {
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		ready.push_back(waiting);
+	}
+	wake.notify_one();
+}
+
+void EventLoop::postAt(std::chrono::steady_clock::time_point due,
+		std::coroutine_handle<> waiting) {
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		timers.push(Timer { due, waiting });
+	}
+	wake.notify_one();
+}
+
+EventLoop::~EventLoop() {
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		stopping = true;
+	}
+	wake.notify_all();
+	for (auto &worker : workers)
+		worker.join();
+}
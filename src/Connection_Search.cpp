@@ -0,0 +1,154 @@
+/**
+ * @file Connection_Search.cpp
+ * @brief Implements the multi-leg connection search
+ * @details Provides:
+ *          - Flight graph construction (airport interning, legs grouped by origin)
+ *          - Label-setting search with stop limit and dominance pruning
+ *
+ * @author Abdallah Salem
+ */
+#include "../include/Connection_Search.hpp"
+#include "../include/Search_Cache.hpp"
+#include <queue>
+#include <limits>
+#include <numeric>
+#include <algorithm>
+
+ConnectionSearch::ConnectionSearch(std::vector<FlightLeg> &&all_legs,
+		int min_connection_minutes, int max_layover_minutes) :
+		min_connection(min_connection_minutes), max_layover(
+				max_layover_minutes) {
+	//intern airports.
+	std::vector<std::uint32_t> from_id(all_legs.size()), to_id(all_legs.size());
+	auto intern = [this](const std::string &name) {
+		return airports.emplace(normalizeSearchText(name),
+				(std::uint32_t) airports.size()).first->second;
+	};
+	for (std::size_t i = 0; i < all_legs.size(); i++) {
+		from_id[i] = intern(all_legs[i].from);
+		to_id[i] = intern(all_legs[i].to);
+	}
+	//group by origin, then by departure.
+	std::vector<std::uint32_t> order(all_legs.size());
+	std::iota(order.begin(), order.end(), 0);
+	std::sort(order.begin(), order.end(),
+			[&](std::uint32_t a, std::uint32_t b) {
+				if (from_id[a] != from_id[b])
+					return from_id[a] < from_id[b];
+				return all_legs[a].departure < all_legs[b].departure;
+			});
+	legs.reserve(all_legs.size());
+	for (std::uint32_t i : order) {
+		origin.push_back(from_id[i]);
+		destination.push_back(to_id[i]);
+		departure.push_back(all_legs[i].departure.minuteNumber());
+		arrival.push_back(all_legs[i].arrival.minuteNumber());
+		legs.push_back(std::move(all_legs[i]));
+	}
+	first_departure.assign(airports.size() + 1, 0);
+	for (std::uint32_t from : origin)
+		first_departure[from + 1]++;
+	std::partial_sum(first_departure.begin(), first_departure.end(),
+			first_departure.begin());
+}
+
+bool ConnectionSearch::airport(const std::string &name,
+		std::uint32_t &id) const {
+	auto found = airports.find(normalizeSearchText(name));
+	if (found == airports.end())
+		return false;
+	id = found->second;
+	return true;
+}
+
+/**
+ * @brief A partial connection ending with a leg.
+ */
+struct ConnectionLabel {
+	std::uint32_t leg;      ///< Last leg.
+	int stops;              ///< Stops so far.
+	Money price;            ///< Price so far.
+	std::int32_t start;     ///< First departure.
+	double cost;            ///< Cost the search minimizes.
+	std::int32_t parent;    ///< Label of the previous leg, -1 for the first.
+};
+
+std::vector<Connection> ConnectionSearch::search(const std::string &from,
+		const std::string &to, DateTime earliest, DateTime latest,
+		int max_stops, ConnectionGoal goal, std::size_t limit) const {
+	std::vector<Connection> found;
+	std::uint32_t source, target;
+	if (!airport(from, source) || !airport(to, target) || source == target
+			|| max_stops < 0 || limit == 0)
+		return found;
+	const std::size_t levels = (std::size_t) max_stops + 1;
+	//best cost per (leg, stops); a label is dominated by one with fewer stops too.
+	std::vector<double> best(legs.size() * levels,
+			std::numeric_limits<double>::infinity());
+	std::vector<ConnectionLabel> labels;
+	typedef std::pair<double, std::int32_t> Entry;
+	std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+	auto push = [&](std::uint32_t leg, int stops, Money price,
+			std::int32_t start, std::int32_t parent) {
+		double cost =
+				goal == ConnectionGoal::CHEAPEST ?
+						(double) price.minorUnits() :
+						(double) (arrival[leg] - start);
+		for (int s = 0; s <= stops; s++)
+			if (best[leg * levels + s] <= cost)
+				return;
+		best[leg * levels + stops] = cost;
+		labels.push_back( { leg, stops, price, start, cost, parent });
+		queue.emplace(cost, (std::int32_t) labels.size() - 1);
+	};
+	//first legs: departures from the origin inside the window.
+	const std::int32_t *departures = departure.data();
+	std::uint32_t first = (std::uint32_t) (std::lower_bound(
+			departures + first_departure[source],
+			departures + first_departure[source + 1], earliest.minuteNumber())
+			- departures);
+	for (std::uint32_t leg = first;
+			leg < first_departure[source + 1]
+					&& departure[leg] <= latest.minuteNumber(); leg++)
+		push(leg, 0, legs[leg].price, departure[leg], -1);
+	while (!queue.empty() && found.size() < limit) {
+		Entry top = queue.top();
+		queue.pop();
+		ConnectionLabel label = labels[top.second];
+		//stale entry, a cheaper label replaced it.
+		if (best[label.leg * levels + label.stops] < label.cost)
+			continue;
+		std::uint32_t at = destination[label.leg];
+		if (at == target) {
+			Connection connection;
+			connection.price = label.price;
+			connection.minutes = arrival[label.leg] - label.start;
+			for (std::int32_t i = top.second; i >= 0; i = labels[i].parent)
+				connection.legs.push_back(labels[i].leg);
+			std::reverse(connection.legs.begin(), connection.legs.end());
+			found.push_back(std::move(connection));
+			continue;
+		}
+		if (label.stops == max_stops || at == source)
+			continue;
+		//next legs: departures after the connection time, within the layover limit.
+		std::int32_t ready = arrival[label.leg] + min_connection;
+		std::int32_t give_up = arrival[label.leg] + max_layover;
+		std::uint32_t next = (std::uint32_t) (std::lower_bound(
+				departures + first_departure[at],
+				departures + first_departure[at + 1], ready) - departures);
+		for (; next < first_departure[at + 1] && departure[next] <= give_up;
+				next++)
+			push(next, label.stops + 1, label.price + legs[next].price,
+					label.start, top.second);
+	}
+	return found;
+}
+
+const FlightLeg& ConnectionSearch::leg(std::uint32_t index) const {
+	return legs[index];
+}
+
+std::size_t ConnectionSearch::size() const {
+	return legs.size();
+}
@@ -0,0 +1,129 @@
+/**
+ * @file Date.cpp
+ * @brief Implements the compact date and date-time types
+ * @details Provides:
+ *          - Conversion between calendar fields and day counts
+ *          - Parsing of "dd-mm-yyyy" and "dd-mm-yyyy hh:mm"
+ *          - Formatting back to the same text forms
+ *
+ * @author Abdallah Salem
+ */
+#include "../include/Date.hpp"
+#include <cstdio>
+
+/**
+ * @brief Number of days in a month of a given year.
+ */
+static int daysInMonth(int month, int year) {
+	static const int days[] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+	bool leap = (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+	return (month == 2 && leap) ? 29 : days[month - 1];
+}
+
+/**
+ * @brief Reads a fixed-width run of digits.
+ * @return The value, or -1 if a non-digit is found.
+ */
+static int readNumber(std::string_view text, std::size_t from, std::size_t width) {
+	int value { };
+	for (std::size_t i = from; i < from + width; i++) {
+		if (text[i] < '0' || text[i] > '9')
+			return -1;
+		value = value * 10 + (text[i] - '0');
+	}
+	return value;
+}
+
+Date Date::fromCivil(int day, int month, int year) {
+	if (month < 1 || month > 12 || day < 1 || day > daysInMonth(month, year)
+			|| year > MAX_YEAR)
+		return Date();
+	//days from civil, counted in 400-year eras starting on 1st of March.
+	year -= month <= 2;
+	const int era = (year >= 0 ? year : year - 399) / 400;
+	const int year_of_era = year - era * 400;
+	const int day_of_year = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day
+			- 1;
+	const int day_of_era = year_of_era * 365 + year_of_era / 4
+			- year_of_era / 100 + day_of_year;
+	return Date(era * 146097 + day_of_era - 719468);
+}
+
+Date Date::parse(std::string_view text) {
+	//expected form: dd-mm-yyyy
+	if (text.size() != 10 || text[2] != '-' || text[5] != '-')
+		return Date();
+	int day = readNumber(text, 0, 2);
+	int month = readNumber(text, 3, 2);
+	int year = readNumber(text, 6, 4);
+	if (day < 0 || month < 0 || year < 0)
+		return Date();
+	return Date::fromCivil(day, month, year);
+}
+
+std::string Date::toString() const {
+	if (!isValid())
+		return "";
+	//civil from days, inverse of fromCivil.
+	const int shifted = days + 719468;
+	const int era = (shifted >= 0 ? shifted : shifted - 146096) / 146097;
+	const int day_of_era = shifted - era * 146097;
+	const int year_of_era = (day_of_era - day_of_era / 1460
+			+ day_of_era / 36524 - day_of_era / 146096) / 365;
+	const int day_of_year = day_of_era
+			- (365 * year_of_era + year_of_era / 4 - year_of_era / 100);
+	const int month_index = (5 * day_of_year + 2) / 153;
+	const int day = day_of_year - (153 * month_index + 2) / 5 + 1;
+	const int month = month_index < 10 ? month_index + 3 : month_index - 9;
+	const int year = year_of_era + era * 400 + (month <= 2);
+	char text[32];
+	std::snprintf(text, sizeof(text), "%02d-%02d-%04d", day, month, year);
+	return text;
+}
+
+std::ostream& operator<<(std::ostream &out, const Date &date) {
+	return out << date.toString();
+}
+
+DateTime DateTime::parse(std::string_view text) {
+	//expected form: dd-mm-yyyy, optionally followed by " hh:mm"
+	Date day = Date::parse(text.substr(0, 10));
+	if (!day.isValid())
+		return DateTime();
+	if (text.size() == 10)
+		return DateTime(day);
+	if (text.size() != 16 || (text[10] != ' ' && text[10] != 'T')
+			|| text[13] != ':')
+		return DateTime();
+	int hour = readNumber(text, 11, 2);
+	int minute = readNumber(text, 14, 2);
+	if (hour < 0 || hour > 23 || minute < 0 || minute > 59)
+		return DateTime();
+	return DateTime(day.dayNumber() * MINUTES_PER_DAY + hour * 60 + minute);
+}
+
+Date DateTime::date() const {
+	if (!isValid())
+		return Date();
+	//floor division, so moments before 1970 land on the right day.
+	std::int32_t day = minutes / MINUTES_PER_DAY;
+	if (minutes % MINUTES_PER_DAY < 0)
+		day--;
+	return Date(day);
+}
+
+std::string DateTime::toString() const {
+	if (!isValid())
+		return "";
+	std::int32_t minute_of_day = minutes - date().dayNumber() * MINUTES_PER_DAY;
+	if (minute_of_day == 0)
+		return date().toString();
+	char time[16];
+	std::snprintf(time, sizeof(time), " %02d:%02d", (int) (minute_of_day / 60),
+			(int) (minute_of_day % 60));
+	return date().toString() + time;
+}
+
+std::ostream& operator<<(std::ostream &out, const DateTime &date_time) {
+	return out << date_time.toString();
+}
@@ -23,11 +23,12 @@ void Manager::firtOptions() {
 
 void Manager::secondOptions() {
 	std::cout
-			<< "1- View Profile.\n2- Make Itinerary.\n3- List My Itineraries.\n4- Logout.\n";
+			<< "1- View Profile.\n2- Make Itinerary.\n3- List My Itineraries.\n4- Logout.\n5- Provider Statistics.\n";
 }
 
 void Manager::thirdOptions() {
-	std::cout << "1- Add Flight.\n2- Add Hotel.\n3- Save.\n4- Cancel.\n";
+	std::cout
+			<< "1- Add Flight.\n2- Add Hotel.\n3- Save.\n4- Cancel.\n5- Add Connecting Flight.\n";
 }
 
 void Manager::save() {
@@ -37,8 +38,22 @@ void Manager::save() {
 	}
 	if (!Payment_Handler->setTransactionInfo())    //be sure that info is set.
 		return;
-	if (!Payment_Handler->makeThePayment())     //be sure that payment is made.
+	CommitOutcome booking = ItineraryCommit::commit(
+			*Itinerary_Builder->getItinerary());
+	if (!booking.committed()) {
+		std::cout << "Could not book " << booking.count(BookingState::FAILED)
+				<< " of " << booking.bookings.size()
+				<< " reservations, nothing was charged.\n";
+		if (booking.count(BookingState::STRANDED))
+			std::cout << booking.count(BookingState::STRANDED)
+					<< " bookings could not be released, contact the provider.\n";
+		return;
+	}
+	if (!Payment_Handler->makeThePayment(
+			Itinerary_Builder->getItinerary()->getCost())) { //be sure that payment is made.
+		ItineraryCommit::cancel(*Itinerary_Builder->getItinerary());
 		return;
+	}
 	User_Manager->addItineraryToUser(Itinerary_Builder->getItinerary());
 	Itinerary_Builder->clearItinerary();
 }
@@ -57,10 +72,23 @@ void Manager::addItinerary(std::string input) {
 		} else if (input == "4") {
 			Itinerary_Builder->clearItinerary();    //call it off
 			return;
-		}
+		} else if (input == "5")
+			Itinerary_Builder->addConnectingFlight();
 	}
 }
 
+void Manager::providerStatistics() {
+	std::cout << "\nProvider calls:\n";
+	CallMetrics::dump(std::cout);
+	std::cout << "\nProvider limiters:\n";
+	for (const LimiterStats &limiter : ProviderLimiter::allStats())
+		std::cout << limiter << "\n";
+	std::cout << "\nProvider searches:\n";
+	for (const SearchStats &search : AdapterRegistry::instance().searchStats())
+		std::cout << search << "\n";
+	std::cout << "\n";
+}
+
 Manager_shared_ptr Manager::getInstance() {
 	if (!OnlyOneInstance)
 		OnlyOneInstance = std::make_shared<Manager>();   //only one instance.
@@ -91,7 +119,8 @@ void Manager::runManager() {
 			else if (input == "4") {
 				User_Manager->logoutUser();
 				Itinerary_Builder->clearItinerary();
-			}
+			} else if (input == "5")
+				Manager::providerStatistics();
 		}
 	}
 }
@@ -10,8 +10,8 @@
 
 #include"../include/Flight_Reservation_Info.hpp"
 
-FoundFlightInfo::FoundFlightInfo(std::string airline, double price,
-		std::string from_date, std::string to_date) :
+FoundFlightInfo::FoundFlightInfo(ProviderId airline, Money price,
+		DateTime from_date, DateTime to_date) :
 		airline(airline), price(price), from_date(from_date), to_date(to_date) {
 
 }
@@ -23,7 +23,7 @@ FoundFlightInfo::FoundFlightInfo(const FoundFlightInfo &other) :
 }
 
 FoundFlightInfo::FoundFlightInfo(FoundFlightInfo &&other) :
-		airline(std::move(other.airline)), price(std::move(other.price)), from_date(
+		airline(other.airline), price(std::move(other.price)), from_date(
 				std::move(other.from_date)), to_date(std::move(other.to_date)) {
 
 }
@@ -40,7 +40,7 @@ FoundFlightInfo& FoundFlightInfo::operator=(const FoundFlightInfo &other) {
 
 FoundFlightInfo& FoundFlightInfo::operator=(FoundFlightInfo &&other) {
 	if (this != &other) {
-		airline = std::move(other.airline);
+		airline = other.airline;
 		price = std::move(other.price);
 		from_date = std::move(other.from_date);
 		to_date = std::move(other.to_date);
@@ -48,8 +48,8 @@ FoundFlightInfo& FoundFlightInfo::operator=(FoundFlightInfo &&other) {
 	return *this;
 }
 
-PassengerInfo::PassengerInfo(std::string from_date, std::string to_date,
-		std::string from, std::string to, int children, int adults, int infants) :
+PassengerInfo::PassengerInfo(Date from_date, Date to_date, std::string from,
+		std::string to, int children, int adults, int infants) :
 		from_date(from_date), to_date(to_date), from(from), to(to), children(
 				children), adults(adults), infants(infants) {
 }
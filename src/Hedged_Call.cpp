@@ -0,0 +1,93 @@
+/**
+ * @file Hedged_Call.cpp
+ * @brief Implements latency tracking and the hedge budget
+ * @details Provides:
+ *          - Sliding-window latency percentiles
+ *          - Hedge budget configuration and accounting
+ *          - The worker pool blocking requests and their hedges run on
+ *
+ * @author Abdallah Salem
+ */
+#include "../include/Hedged_Call.hpp"
+#include "../include/Search_Fan_Out.hpp"
+#include <cstdlib>
+#include <algorithm>
+
+LatencyTracker::LatencyTracker(std::size_t window) :
+		window(window ? window : 1) {
+	samples.reserve(this->window);
+}
+
+void LatencyTracker::record(std::chrono::microseconds latency) {
+	std::lock_guard<std::mutex> guard(lock);
+	if (samples.size() < window)
+		samples.push_back(latency.count());
+	else {
+		samples[next] = latency.count();
+		next = (next + 1) % window;
+	}
+}
+
+std::chrono::microseconds LatencyTracker::percentile(double fraction) const {
+	std::vector<std::int64_t> sorted;
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		sorted = samples;
+	}
+	if (sorted.empty())
+		return std::chrono::microseconds(0);
+	std::size_t rank = std::min(sorted.size() - 1,
+			(std::size_t) (fraction * (double) sorted.size()));
+	std::nth_element(sorted.begin(), sorted.begin() + rank, sorted.end());
+	return std::chrono::microseconds(sorted[rank]);
+}
+
+std::size_t LatencyTracker::count() const {
+	std::lock_guard<std::mutex> guard(lock);
+	return samples.size();
+}
+
+/**
+ * @brief Reads the hedge budget from the environment.
+ */
+static double configuredHedgeBudget() {
+	const char *budget = std::getenv("EXPEDIA_HEDGE_BUDGET");
+	if (!budget)
+		return 0;
+	return std::max(0.0, std::min(1.0, std::atof(budget)));
+}
+
+Hedger::Hedger() :
+		Hedger(configuredHedgeBudget()) {
+}
+
+Hedger::Hedger(double budget) :
+		latencies(std::make_shared<LatencyTracker>()), budget(budget) {
+}
+
+bool Hedger::enabled() const {
+	return budget > 0;
+}
+
+bool Hedger::takeHedge() {
+	//one hedge is always allowed so a cold provider is not starved.
+	if ((double) hedges.load() >= budget * (double) calls.load() + 1)
+		return false;
+	hedges++;
+	return true;
+}
+
+void Hedger::startAttempt(std::function<void()> request) {
+	//a request and its hedge for each of the four providers a search can have in flight.
+	//never destroyed: a request still stuck on its provider must not hold up exit.
+	static WorkerPool *pool = new WorkerPool(8);
+	pool->submit(std::move(request));
+}
+
+std::uint64_t Hedger::hedgeCount() const {
+	return hedges.load();
+}
+
+std::chrono::microseconds Hedger::percentile(double fraction) const {
+	return latencies->percentile(fraction);
+}
@@ -5,13 +5,29 @@
  *          - Hotel customer info and room data classes
  *          - API interaction methods for room search and reservations
  *          - Dummy data generation for demonstration purposes
+ *          - Switching to the provider simulator when it is active
+ *          - Coroutine variants that wait on the simulator without holding a thread
  *
  * @author Abdallah Salem
  */
 #include"../include/Hotel_APIs.hpp"
+#include"../include/Provider_Simulator.hpp"
+
+/**
+ * @brief Converts simulated rooms into a hotel's room records.
+ */
+template<typename Room>
+static std::vector<Room> toRooms(const std::vector<SimulatedRoom> &simulated) {
+	std::vector<Room> rooms;
+	rooms.reserve(simulated.size());
+	for (const SimulatedRoom &room : simulated)
+		rooms.push_back(Room { room.room_type, room.available,
+				room.price_per_night, room.from, room.to });
+	return rooms;
+}
 
 HiltonCustomerInfo::HiltonCustomerInfo(std::string country, std::string city,
-		std::string date_from, std::string date_to, int needed_rooms,
+		Date date_from, Date date_to, int needed_rooms,
 		int adults, int children, int number_of_nights) :
 		country(country), city(city), date_from(date_from), date_to(date_to), needed_rooms(
 				needed_rooms), adults(adults), children(children), number_of_nights(
@@ -20,7 +36,7 @@ HiltonCustomerInfo::HiltonCustomerInfo(std::string country, std::string city,
 }
 
 HiltonRoom::HiltonRoom(std::string room_type, int available_number,
-		double price, std::string from, std::string to) :
+		Money price, Date from, Date to) :
 		room_type(room_type), available_number(available_number), price_per_night(
 				price), from_date(from), to_date(to) {
 
@@ -32,31 +48,65 @@ void HiltonHotelAPI::setCustomerInfo(const HiltonCustomerInfo &customer_info) {
 
 bool HiltonHotelAPI::reserveRoom(const HiltonCustomerInfo &customer_info,
 		const HiltonRoom &room_info) {
+	if (ProviderSimulator::instance().isActive())
+		return ProviderSimulator::instance().call("Hilton");
 	//suppose the API reserve the room successfully.
 	return true;
 }
 
 bool HiltonHotelAPI::cancelReservation(const HiltonCustomerInfo &customer_info,
 		const HiltonRoom &room_info) {
+	if (ProviderSimulator::instance().isActive())
+		return ProviderSimulator::instance().call("Hilton");
 	//suppose the API cancel the reservation successfully.
 	return true;
 }
 
 std::vector<HiltonRoom> HiltonHotelAPI::searchRooms(
 		HiltonCustomerInfo &customer_info) {
+	ProviderSimulator &simulator = ProviderSimulator::instance();
+	if (simulator.isActive())
+		return toRooms<HiltonRoom>(
+				simulator.searchRooms("Hilton", customer_info.city,
+						customer_info.date_from, customer_info.date_to));
 	std::vector < HiltonRoom > rooms;
 	//dummy data sent by the API
-	rooms.push_back(HiltonRoom { "Interior View", 6, 200, "29-01-2022",
-			"10-02-2022" });
-	rooms.push_back(
-			HiltonRoom { "City View", 3, 300, "29-01-2022", "10-02-2022" });
-	rooms.push_back(HiltonRoom { "Deluxe View", 8, 500, "29-01-2022",
-			"10-02-2022" });
+	rooms.push_back(HiltonRoom { "Interior View", 6, Money(20000), Date::parse(
+			"29-01-2022"), Date::parse("10-02-2022") });
+	rooms.push_back(HiltonRoom { "City View", 3, Money(30000), Date::parse("29-01-2022"),
+			Date::parse("10-02-2022") });
+	rooms.push_back(HiltonRoom { "Deluxe View", 8, Money(50000), Date::parse(
+			"29-01-2022"), Date::parse("10-02-2022") });
 	return rooms;
 }
 
+Task<std::vector<HiltonRoom>> HiltonHotelAPI::searchRoomsAsync(
+		EventLoop &loop, HiltonCustomerInfo customer_info) {
+	ProviderSimulator &simulator = ProviderSimulator::instance();
+	if (!simulator.isActive())
+		co_return searchRooms(customer_info);
+	co_return toRooms<HiltonRoom>(
+			co_await simulator.searchRoomsAsync(loop, "Hilton",
+					customer_info.city, customer_info.date_from,
+					customer_info.date_to));
+}
+
+Task<bool> HiltonHotelAPI::reserveRoomAsync(EventLoop &loop,
+		HiltonCustomerInfo customer_info, HiltonRoom room_info) {
+	if (!ProviderSimulator::instance().isActive())
+		co_return reserveRoom(customer_info, room_info);
+	co_return co_await ProviderSimulator::instance().callAsync(loop, "Hilton");
+}
+
+Task<bool> HiltonHotelAPI::cancelReservationAsync(EventLoop &loop,
+		HiltonCustomerInfo customer_info, HiltonRoom room_info) {
+	if (!ProviderSimulator::instance().isActive())
+		co_return cancelReservation(customer_info, room_info);
+	co_return co_await ProviderSimulator::instance().callAsync(loop, "Hilton");
+}
+
 MarriottCustomerInfo::MarriottCustomerInfo(std::string country,
-		std::string city, std::string date_from, std::string date_to,
+		std::string city, Date date_from, Date date_to,
 		int needed_rooms, int adults, int children, int number_of_nights) :
 		country(country), city(city), date_from(date_from), date_to(date_to), needed_rooms(
 				needed_rooms), adults(adults), children(children), number_of_nights(
@@ -65,7 +115,7 @@ MarriottCustomerInfo::MarriottCustomerInfo(std::string country,
 }
 
 MarriottFoundRoom::MarriottFoundRoom(std::string type, int available_number,
-		double price, std::string from, std::string to) :
+		Money price, Date from, Date to) :
 		room_type(type), available_number(available_number), price_per_night(
 				price), date_from(from), date_to(to) {
 }
@@ -78,22 +128,59 @@ void MarriottHotelAPI::setCustomerInfo(
 
 std::vector<MarriottFoundRoom> MarriottHotelAPI::findRooms(
 		const MarriottCustomerInfo &customer_info) {
+	ProviderSimulator &simulator = ProviderSimulator::instance();
+	if (simulator.isActive())
+		return toRooms<MarriottFoundRoom>(
+				simulator.searchRooms("Marriott", customer_info.city,
+						customer_info.date_from, customer_info.date_to));
 	std::vector < MarriottFoundRoom > rooms;
 	//dummy data sent by the API
-	rooms.push_back( { "City View", 8, 320, "29-01-2022", "10-02-2022" });
-	rooms.push_back( { "Interior View", 8, 220, "29-01-2022", "10-02-2022" });
-	rooms.push_back( { "Private View", 5, 600, "29-01-2022", "10-02-2022" });
+	rooms.push_back( { "City View", 8, Money(32000), Date::parse("29-01-2022"),
+			Date::parse("10-02-2022") });
+	rooms.push_back( { "Interior View", 8, Money(22000), Date::parse("29-01-2022"),
+			Date::parse("10-02-2022") });
+	rooms.push_back( { "Private View", 5, Money(60000), Date::parse("29-01-2022"),
+			Date::parse("10-02-2022") });
 	return rooms;
 }
 
 bool MarriottHotelAPI::cancelReservation(const MarriottFoundRoom &room_info,
 		const MarriottCustomerInfo &customer_info) {
+	if (ProviderSimulator::instance().isActive())
+		return ProviderSimulator::instance().call("Marriott");
 	//suppose API cancel the reservation successfully.
 	return true;
 }
 
 bool MarriottHotelAPI::reserveRoom(const MarriottFoundRoom &room_info,
 		const MarriottCustomerInfo &customer_info) {
+	if (ProviderSimulator::instance().isActive())
+		return ProviderSimulator::instance().call("Marriott");
 	//suppose the API reserve the room successfully.
 	return true;
 }
+
+Task<std::vector<MarriottFoundRoom>> MarriottHotelAPI::findRoomsAsync(
+		EventLoop &loop, MarriottCustomerInfo customer_info) {
+	ProviderSimulator &simulator = ProviderSimulator::instance();
+	if (!simulator.isActive())
+		co_return findRooms(customer_info);
+	co_return toRooms<MarriottFoundRoom>(
+			co_await simulator.searchRoomsAsync(loop, "Marriott",
+					customer_info.city, customer_info.date_from,
+					customer_info.date_to));
+}
+
+Task<bool> MarriottHotelAPI::reserveRoomAsync(EventLoop &loop,
+		MarriottFoundRoom room_info, MarriottCustomerInfo customer_info) {
+	if (!ProviderSimulator::instance().isActive())
+		co_return reserveRoom(room_info, customer_info);
+	co_return co_await ProviderSimulator::instance().callAsync(loop, "Marriott");
+}
+
+Task<bool> MarriottHotelAPI::cancelReservationAsync(EventLoop &loop,
+		MarriottFoundRoom room_info, MarriottCustomerInfo customer_info) {
+	if (!ProviderSimulator::instance().isActive())
+		co_return cancelReservation(room_info, customer_info);
+	co_return co_await ProviderSimulator::instance().callAsync(loop, "Marriott");
+}
@@ -11,7 +11,7 @@
 #include"../include/Hotel_Reservation_Info.hpp"
 
 FoundRoomInfo::FoundRoomInfo(FoundRoomInfo &&other) :
-		hotel(std::move(other.hotel)), from_date(std::move(other.from_date)), to_date(
+		hotel(other.hotel), from_date(std::move(other.from_date)), to_date(
 				std::move(other.to_date)), view_type(
 				std::move(other.view_type)), how_many(
 				std::move(other.how_many)), price_for_night(
@@ -26,8 +26,8 @@ FoundRoomInfo::FoundRoomInfo(const FoundRoomInfo &other) :
 
 }
 
-FoundRoomInfo::FoundRoomInfo(std::string hotel, std::string from_date,
-		std::string to_date, std::string view_type, int how_many, double price) :
+FoundRoomInfo::FoundRoomInfo(ProviderId hotel, Date from_date,
+		Date to_date, std::string view_type, int how_many, Money price) :
 		hotel(hotel), from_date(from_date), to_date(to_date), view_type(
 				view_type), how_many(how_many), price_for_night(price) {
 
@@ -46,7 +46,7 @@ FoundRoomInfo& FoundRoomInfo::operator=(const FoundRoomInfo &other) {
 
 FoundRoomInfo& FoundRoomInfo::operator=(FoundRoomInfo &&other) {
 	if (this != &other) {
-		hotel = std::move(other.hotel);
+		hotel = other.hotel;
 		to_date = std::move(other.to_date);
 		from_date = std::move(other.from_date);
 		view_type = std::move(other.view_type);
@@ -56,7 +56,7 @@ FoundRoomInfo& FoundRoomInfo::operator=(FoundRoomInfo &&other) {
 	return *this;
 }
 
-CustomerInfo::CustomerInfo(std::string from_date, std::string to_date,
+CustomerInfo::CustomerInfo(Date from_date, Date to_date,
 		std::string country, std::string city, int children, int adults,
 		int needed_rooms, int number_of_nights) :
 		from_date(from_date), to_date(to_date), country(country), city(city), children(
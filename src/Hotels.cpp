@@ -5,231 +5,505 @@
  *          - HiltonHotelReservation: Adapter for Hilton hotels
  *          - MarriottHotelReservation: Adapter for Marriott hotels
  *          - Handles data conversion between system and hotel APIs
+ *          - Searches each chain through a ProviderSearch (cache per stay, shared,
+ *            hedged, limited and measured API calls)
+ *          - Reconciles cached availability with our own bookings
+ *          - Indexes local hotel inventory by location, or maps its binary inventory file
+ *          - Coroutine search and booking on an EventLoop
+ *          - Registers both chains with the adapter registry
  *
  * @author Abdallah Salem
  */
 #include"../include/Hotels.hpp"
+#include"../include/Inventory_Index.hpp"
+#include"../include/Mapped_Inventory.hpp"
+#include"../include/Adapter_Registry.hpp"
+#include"../include/Provider_Simulator.hpp"
+#include"../include/Provider_Search.hpp"
+
+/**
+ * @brief Builds the cache key of a room search.
+ * @details The number of needed rooms is not part of the key: the chains report the
+ *          same availability for any room count, so every request for a city and stay
+ *          shares one entry and sees our own bookings reflected in it.
+ * @return Key made of the normalized location and dates.
+ */
+static std::string roomSearchKey(const CustomerInfo &query) {
+	return normalizeSearchText(query.country) + "|"
+			+ normalizeSearchText(query.city) + "|"
+			+ std::to_string(query.from_date.dayNumber()) + "|"
+			+ std::to_string(query.to_date.dayNumber());
+}
+
+/**
+ * @brief Puts a customer request in Hilton's format, right before calling it.
+ */
+static HiltonCustomerInfo hiltonRequest(const CustomerInfo &query) {
+	return HiltonCustomerInfo(query.country, query.city, query.from_date,
+			query.to_date, query.needed_rooms, query.adults, query.children,
+			query.number_of_nights);
+}
+
+/**
+ * @brief Puts a customer request in Marriott's format, right before calling it.
+ */
+static MarriottCustomerInfo marriottRequest(const CustomerInfo &query) {
+	return MarriottCustomerInfo(query.country, query.city, query.from_date,
+			query.to_date, query.needed_rooms, query.adults, query.children,
+			query.number_of_nights);
+}
+
+/**
+ * @brief Request of adapters not given one yet.
+ */
+static const CustomerQuery& noGuests() {
+	static const CustomerQuery empty = std::make_shared<const CustomerInfo>();
+	return empty;
+}
+
+/**
+ * @brief Loads a room inventory, mapping its binary file when there is one.
+ * @details "<name>.inv" is mapped and searched in place. Otherwise "<name>.csv" is read
+ *          into a location index; its lines are "country, city, room type, available,
+ *          price per night, from, to", dates as dd-mm-yyyy. With neither file the inventory
+ *          is empty.
+ * @param name Inventory file name without its extension.
+ * @return The inventory.
+ */
+template<typename Room>
+static ProviderInventory<Room> loadRoomInventory(const std::string &name) {
+	auto mapped = std::make_unique<MappedInventory>(inventoryPath(name + ".inv"));
+	if (mapped->isOpen())
+		return ProviderInventory<Room>(std::move(mapped),
+				[](const MappedInventory &file, const InventoryRecord &record) {
+					return Room { file.text(record.label), record.count,
+							Money(record.price), Date(record.from), Date(record.to) };
+				});
+	InventoryIndex<Room> index;
+	readInventoryFile(inventoryPath(name + ".csv"),
+			[&](const std::vector<std::string> &fields) {
+				int available { };
+				Money price;
+				if (fields.size() != 7
+						|| !parseInventoryNumber(fields[3], available)
+						|| !parseInventoryNumber(fields[4], price))
+					return false;
+				Date from = Date::parse(fields[5]);
+				Date to = Date::parse(fields[6]);
+				if (!from.isValid() || !to.isValid())
+					return false;
+				index.add(fields[0], fields[1],
+						Room { fields[2], available, price, from, to });
+				return true;
+			});
+	return ProviderInventory<Room>(std::move(index));
+}
+
+/**
+ * @brief Hilton inventory by location, loaded on first use from hilton_rooms.inv or
+ *        hilton_rooms.csv.
+ */
+static const ProviderInventory<HiltonRoom>& hiltonInventory() {
+	static const ProviderInventory<HiltonRoom> inventory = loadRoomInventory<
+			HiltonRoom>("hilton_rooms");
+	return inventory;
+}
+
+/**
+ * @brief Marriott inventory by location, loaded on first use from marriott_rooms.inv or
+ *        marriott_rooms.csv.
+ */
+static const ProviderInventory<MarriottFoundRoom>& marriottInventory() {
+	static const ProviderInventory<MarriottFoundRoom> inventory =
+			loadRoomInventory<MarriottFoundRoom>("marriott_rooms");
+	return inventory;
+}
+
+/**
+ * @brief Limits the Hilton calls in flight and stops calling it while it keeps failing.
+ */
+static ProviderLimiter& hiltonLimiter() {
+	return ProviderLimiter::forProvider("Hilton");
+}
+
+/**
+ * @brief Latency and outcome of every Hilton API call.
+ */
+static BookingCallMetrics& hiltonMetrics() {
+	static BookingCallMetrics metrics("Hilton");
+	return metrics;
+}
+
+/**
+ * @brief Limits the Marriott calls in flight and stops calling it while it keeps failing.
+ */
+static ProviderLimiter& marriottLimiter() {
+	return ProviderLimiter::forProvider("Marriott");
+}
+
+/**
+ * @brief Latency and outcome of every Marriott API call.
+ */
+static BookingCallMetrics& marriottMetrics() {
+	static BookingCallMetrics metrics("Marriott");
+	return metrics;
+}
+
+/**
+ * @brief Answers a room search from a chain's location index.
+ * @return The rooms in the city, nullopt when the chain has no inventory.
+ */
+template<typename Room>
+static std::optional<std::vector<Room>> stockedRooms(
+		const ProviderInventory<Room> &inventory, const CustomerInfo &query) {
+	if (inventory.empty())
+		return std::nullopt;
+	return inventory.find(query.country, query.city);
+}
+
+/**
+ * @brief Hilton searches, answered from the availability cache, the location index in
+ *        hilton_rooms.inv or .csv, or HiltonHotelAPI::searchRooms.
+ */
+static ProviderSearch<HiltonRoom, CustomerInfo, HiltonCustomerInfo>& hiltonSearch() {
+	static ProviderSearch<HiltonRoom, CustomerInfo, HiltonCustomerInfo> search(
+			"Hilton", hiltonMetrics().search, 512, std::chrono::seconds(120), {
+					roomSearchKey, hiltonRequest, [](const CustomerInfo &query) {
+						return stockedRooms(hiltonInventory(), query);
+					}, HiltonHotelAPI::searchRooms, HiltonHotelAPI::searchRoomsAsync });
+	return search;
+}
+
+/**
+ * @brief Marriott searches, answered from the availability cache, the location index in
+ *        marriott_rooms.inv or .csv, or MarriottHotelAPI::findRooms.
+ */
+static ProviderSearch<MarriottFoundRoom, CustomerInfo, MarriottCustomerInfo>& marriottSearch() {
+	static ProviderSearch<MarriottFoundRoom, CustomerInfo, MarriottCustomerInfo> search(
+			"Marriott", marriottMetrics().search, 512, std::chrono::seconds(120), {
+					roomSearchKey, marriottRequest, [](const CustomerInfo &query) {
+						return stockedRooms(marriottInventory(), query);
+					}, MarriottHotelAPI::findRooms, MarriottHotelAPI::findRoomsAsync });
+	return search;
+}
 
 HiltonHotelReservation::HiltonHotelReservation() :
-		hilton_customer_info(std::make_unique<HiltonCustomerInfo>()), hilton_chosen_room(
-				std::make_unique<HiltonRoom>()) {
+		customer_query(noGuests()) {
 }
 
-HiltonHotelReservation::HiltonHotelReservation(CustomerInfo_ptr &&customer_info,
+HiltonHotelReservation::HiltonHotelReservation(CustomerQuery customer_info,
 		RoomInfo_ptr &&chosen_room) :
 		HiltonHotelReservation() {
 	HiltonHotelReservation::setCustomerInfo(std::move(customer_info));
 	HiltonHotelReservation::setChosenRoomInfo(std::move(chosen_room));
 }
 
+//the request is shared and read-only, so copies share it too.
 HiltonHotelReservation::HiltonHotelReservation(
-		const HiltonHotelReservation &other) :
-		HiltonHotelReservation() {
-	*(hilton_customer_info) = *(other.hilton_customer_info);
-	*(hilton_chosen_room) = *(other.hilton_chosen_room);
-}
+		const HiltonHotelReservation &other) = default;
 
-HiltonHotelReservation::HiltonHotelReservation(HiltonHotelReservation &&other) :
-		hilton_customer_info(std::move(other.hilton_customer_info)), hilton_chosen_room(
-				std::move(other.hilton_chosen_room)) {
-
-}
+HiltonHotelReservation::HiltonHotelReservation(HiltonHotelReservation &&other) = default;
 
 HiltonHotelReservation& HiltonHotelReservation::operator =(
-		const HiltonHotelReservation &other) {
-	if (this != &other) {
-		*(hilton_customer_info) = *(other.hilton_customer_info);
-		*(hilton_chosen_room) = *(other.hilton_chosen_room);
-	}
-	return *this;
-}
+		const HiltonHotelReservation &other) = default;
 
 HiltonHotelReservation& HiltonHotelReservation::operator =(
-		HiltonHotelReservation &&other) {
-	if (this != &other) {
-		hilton_customer_info = std::move(other.hilton_customer_info);
-		hilton_chosen_room = std::move(other.hilton_chosen_room);
-	}
-	return *this;
-}
+		HiltonHotelReservation &&other) = default;
 
-void HiltonHotelReservation::setCustomerInfo(CustomerInfo_ptr &&info) {
-	hilton_customer_info->country = info->country;
-	hilton_customer_info->city = info->city;
-	hilton_customer_info->date_from = info->from_date;
-	hilton_customer_info->date_to = info->to_date;
-	hilton_customer_info->adults = info->adults;
-	hilton_customer_info->children = info->children;
-	hilton_customer_info->needed_rooms = info->needed_rooms;
-	hilton_customer_info->number_of_nights = info->number_of_nights;
+void HiltonHotelReservation::setCustomerInfo(CustomerQuery info) {
+	customer_query = std::move(info);
 }
 
 void HiltonHotelReservation::getAvailableRooms(
 		std::vector<FoundRoomInfo> &&rooms) {
-	//dummy data sent by API
-	std::vector < HiltonRoom > available_rooms = HiltonHotelAPI::searchRooms(
-			*hilton_customer_info);
+	std::vector < HiltonRoom > available_rooms = hiltonSearch().find(
+			*customer_query);
 	for (int i = 0; i < (int) available_rooms.size(); i++)
 		rooms.push_back(
-				{ "Hilton", available_rooms[i].from_date,
+				{ HiltonHotelReservation::providerId(),
+						available_rooms[i].from_date,
 						available_rooms[i].to_date,
 						available_rooms[i].room_type,
 						available_rooms[i].available_number,
 						available_rooms[i].price_per_night });
 }
 
+void HiltonHotelReservation::appendAvailableRooms(RoomColumns &columns) {
+	std::vector < HiltonRoom > available_rooms = hiltonSearch().find(
+			*customer_query);
+	columns.reserve(columns.size() + available_rooms.size());
+	for (const HiltonRoom &room : available_rooms)
+		columns.append(HiltonHotelReservation::providerId(), room.from_date, room.to_date,
+				room.room_type, room.available_number, room.price_per_night);
+}
+
+Task<std::vector<FoundRoomInfo>> HiltonHotelReservation::getAvailableRoomsAsync(
+		EventLoop &loop) {
+	Task<std::vector<HiltonRoom>> search = hiltonSearch().findAsync(loop,
+			customer_query);
+	std::vector < HiltonRoom > available_rooms = co_await search;
+	std::vector<FoundRoomInfo> rooms;
+	rooms.reserve(available_rooms.size());
+	for (const HiltonRoom &room : available_rooms)
+		rooms.push_back( { HiltonHotelReservation::providerId(), room.from_date,
+				room.to_date, room.room_type, room.available_number,
+				room.price_per_night });
+	co_return rooms;
+}
+
 void HiltonHotelReservation::setChosenRoomInfo(RoomInfo_ptr &&room_info) {
-	hilton_chosen_room->price_per_night = room_info->price_for_night;
-	hilton_chosen_room->room_type = room_info->view_type;
-	hilton_chosen_room->from_date = room_info->from_date;
-	hilton_chosen_room->to_date = room_info->to_date;
+	hilton_chosen_room.price_per_night = room_info->price_for_night;
+	hilton_chosen_room.room_type = room_info->view_type;
+	hilton_chosen_room.from_date = room_info->from_date;
+	hilton_chosen_room.to_date = room_info->to_date;
 }
 void HiltonHotelReservation::getDetails(std::ostream &&get) const {
 	//collect data in one string.
-	get << "Hotel Reservation / Hilton Hotel: " << hilton_customer_info->country
-			<< " @ " << hilton_customer_info->city << "  from "
-			<< hilton_customer_info->date_from << "  to "
-			<< hilton_customer_info->date_to << " ("
-			<< hilton_customer_info->number_of_nights << ")\n" << "\t\tAdults: "
-			<< hilton_customer_info->adults << "\n\t\tChildren: "
-			<< hilton_customer_info->children
+	get << "Hotel Reservation / Hilton Hotel: " << customer_query->country
+			<< " @ " << customer_query->city << "  from "
+			<< customer_query->from_date << "  to "
+			<< customer_query->to_date << " ("
+			<< customer_query->number_of_nights << ")\n" << "\t\tAdults: "
+			<< customer_query->adults << "\n\t\tChildren: "
+			<< customer_query->children
 			<< "\n\t\tRoom Cost For All Nights: "
 			<< HiltonHotelReservation::getCost() << "\n";
 }
 
+ProviderId HiltonHotelReservation::providerId() {
+	static const ProviderId id = ProviderRegistry::instance().intern("Hilton");
+	return id;
+}
+
+SearchStats HiltonHotelReservation::searchStats() {
+	return hiltonSearch().stats();
+}
+
 Reservation_ptr HiltonHotelReservation::clone() const {
 	return std::make_unique < HiltonHotelReservation > (*this);
 }
 
-bool HiltonHotelReservation::makeReservation() {
-	return HiltonHotelAPI::reserveRoom(*hilton_customer_info,
-			*hilton_chosen_room);
+void HiltonHotelReservation::reconcileAvailability(int rooms_taken) const {
+	std::string key = roomSearchKey(*customer_query);
+	const HiltonRoom &chosen = hilton_chosen_room;
+	hiltonSearch().cache().update(key, [&](std::vector<HiltonRoom> &rooms) {
+		for (auto &room : rooms)
+			if (room.room_type == chosen.room_type
+					&& room.from_date == chosen.from_date
+					&& room.to_date == chosen.to_date)
+				room.available_number = std::max(0,
+						room.available_number - rooms_taken);
+	});
 }
 
-bool HiltonHotelReservation::cancelReservation() {
-	return HiltonHotelAPI::cancelReservation(*hilton_customer_info,
-			*hilton_chosen_room);
+Task<bool> HiltonHotelReservation::makeReservationAsync(EventLoop &loop) {
+	Task<bool> booking = hiltonLimiter().callAsync<bool>(loop, [this, &loop] {
+		return hiltonMetrics().reserve.measureAsync<bool>([this, &loop] {
+			return HiltonHotelAPI::reserveRoomAsync(loop,
+					hiltonRequest(*customer_query), hilton_chosen_room);
+		});
+	}, [] {
+		return false;
+	});
+	bool reserved = co_await booking;
+	if (!reserved)
+		co_return false;
+	//a reservation holds at least one room.
+	reconcileAvailability(std::max(1, customer_query->needed_rooms));
+	co_return true;
 }
 
-double HiltonHotelReservation::getCost() const {
-	return hilton_chosen_room->price_per_night
-			* hilton_customer_info->number_of_nights
-			* hilton_customer_info->needed_rooms;
+Task<bool> HiltonHotelReservation::cancelReservationAsync(EventLoop &loop) {
+	Task<bool> cancellation = hiltonLimiter().callAsync<bool>(loop, [this, &loop] {
+		return hiltonMetrics().cancel.measureAsync<bool>([this, &loop] {
+			return HiltonHotelAPI::cancelReservationAsync(loop,
+					hiltonRequest(*customer_query), hilton_chosen_room);
+		});
+	}, [] {
+		return false;
+	});
+	bool cancelled = co_await cancellation;
+	if (!cancelled)
+		co_return false;
+	reconcileAvailability(-std::max(1, customer_query->needed_rooms));
+	co_return true;
 }
 
-MarriottHotelReservation::MarriottHotelReservation() :
-		marriott_customer_info(std::make_unique<MarriottCustomerInfo>()), marriott_chosen_room(
-				std::make_unique<MarriottFoundRoom>()) {
+Money HiltonHotelReservation::getCost() const {
+	return hilton_chosen_room.price_per_night
+			* customer_query->number_of_nights
+			* customer_query->needed_rooms;
+}
 
+MarriottHotelReservation::MarriottHotelReservation() :
+		customer_query(noGuests()) {
 }
 
-MarriottHotelReservation::MarriottHotelReservation(
-		CustomerInfo_ptr &&customer_info, RoomInfo_ptr &&chosen_room) :
+MarriottHotelReservation::MarriottHotelReservation(CustomerQuery customer_info,
+		RoomInfo_ptr &&chosen_room) :
 		MarriottHotelReservation() {
 	MarriottHotelReservation::setCustomerInfo(std::move(customer_info));
 	MarriottHotelReservation::setChosenRoomInfo(std::move(chosen_room));
 }
 
+//the request is shared and read-only, so copies share it too.
 MarriottHotelReservation::MarriottHotelReservation(
-		const MarriottHotelReservation &other) :
-		MarriottHotelReservation() {
-	//handle ownership of unique pointers.
-	if (other.marriott_customer_info)
-		*(marriott_customer_info) = *(other.marriott_customer_info);
-	if (other.marriott_chosen_room)
-		*(marriott_chosen_room) = *(other.marriott_chosen_room);
-}
-
-MarriottHotelReservation::MarriottHotelReservation(
-		MarriottHotelReservation &&other) :
-		marriott_customer_info(std::move(other.marriott_customer_info)), marriott_chosen_room(
-				std::move(other.marriott_chosen_room)) {
+		const MarriottHotelReservation &other) = default;
 
-}
+MarriottHotelReservation::MarriottHotelReservation(MarriottHotelReservation &&other) = default;
 
 MarriottHotelReservation& MarriottHotelReservation::operator =(
-		const MarriottHotelReservation &other) {
-	if (this != &other) {
-		//handle ownership of unique pointer.
-		if (other.marriott_customer_info)
-			*(marriott_customer_info) = *(other.marriott_customer_info);
-		if (other.marriott_chosen_room)
-			*(marriott_chosen_room) = *(other.marriott_chosen_room);
-	}
-	return *this;
-}
+		const MarriottHotelReservation &other) = default;
 
 MarriottHotelReservation& MarriottHotelReservation::operator =(
-		MarriottHotelReservation &&other) {
-	if (this != &other) {
-		marriott_customer_info = std::move(other.marriott_customer_info);
-		marriott_chosen_room = std::move(other.marriott_chosen_room);
-	}
-	return *this;
-}
+		MarriottHotelReservation &&other) = default;
 
-void MarriottHotelReservation::setCustomerInfo(CustomerInfo_ptr &&info) {
-	marriott_customer_info->country = info->country;
-	marriott_customer_info->city = info->city;
-	marriott_customer_info->date_from = info->from_date;
-	marriott_customer_info->date_to = info->to_date;
-	marriott_customer_info->adults = info->adults;
-	marriott_customer_info->children = info->children;
-	marriott_customer_info->needed_rooms = info->needed_rooms;
-	marriott_customer_info->number_of_nights = info->number_of_nights;
+void MarriottHotelReservation::setCustomerInfo(CustomerQuery info) {
+	customer_query = std::move(info);
 }
 
 void MarriottHotelReservation::getAvailableRooms(
 		std::vector<FoundRoomInfo> &&rooms) {
-	//dummy data sent by API
-	std::vector < MarriottFoundRoom > available_rooms =
-			MarriottHotelAPI::findRooms(*marriott_customer_info);
+	std::vector < MarriottFoundRoom > available_rooms = marriottSearch().find(
+			*customer_query);
 	for (int i = 0; i < (int) available_rooms.size(); i++)
 		rooms.push_back(
-				{ "Marriott", available_rooms[i].date_from,
+				{ MarriottHotelReservation::providerId(),
+						available_rooms[i].date_from,
 						available_rooms[i].date_to,
 						available_rooms[i].room_type,
 						available_rooms[i].available_number,
 						available_rooms[i].price_per_night });
 }
 
+void MarriottHotelReservation::appendAvailableRooms(RoomColumns &columns) {
+	std::vector < MarriottFoundRoom > available_rooms = marriottSearch().find(
+			*customer_query);
+	columns.reserve(columns.size() + available_rooms.size());
+	for (const MarriottFoundRoom &room : available_rooms)
+		columns.append(MarriottHotelReservation::providerId(), room.date_from, room.date_to,
+				room.room_type, room.available_number, room.price_per_night);
+}
+
+Task<std::vector<FoundRoomInfo>> MarriottHotelReservation::getAvailableRoomsAsync(
+		EventLoop &loop) {
+	Task<std::vector<MarriottFoundRoom>> search = marriottSearch().findAsync(
+			loop, customer_query);
+	std::vector < MarriottFoundRoom > available_rooms = co_await search;
+	std::vector<FoundRoomInfo> rooms;
+	rooms.reserve(available_rooms.size());
+	for (const MarriottFoundRoom &room : available_rooms)
+		rooms.push_back( { MarriottHotelReservation::providerId(), room.date_from,
+				room.date_to, room.room_type, room.available_number,
+				room.price_per_night });
+	co_return rooms;
+}
+
 void MarriottHotelReservation::setChosenRoomInfo(RoomInfo_ptr &&room_info) {
-	marriott_chosen_room->price_per_night = room_info->price_for_night;
-	marriott_chosen_room->room_type = room_info->view_type;
-	marriott_chosen_room->date_from = room_info->from_date;
-	marriott_chosen_room->date_to = room_info->to_date;
+	marriott_chosen_room.price_per_night = room_info->price_for_night;
+	marriott_chosen_room.room_type = room_info->view_type;
+	marriott_chosen_room.date_from = room_info->from_date;
+	marriott_chosen_room.date_to = room_info->to_date;
 }
 void MarriottHotelReservation::getDetails(std::ostream &&get) const {
 	//collect all data in one string
 	get << "Hotel Reservation / Marriott Hotel: "
-			<< marriott_customer_info->country << " @ "
-			<< marriott_customer_info->city << "  from "
-			<< marriott_customer_info->date_from << "  to "
-			<< marriott_customer_info->date_to << " ("
-			<< marriott_customer_info->number_of_nights << ")\n"
-			<< "\t\tAdults: " << marriott_customer_info->adults
-			<< "\n\t\tChildren: " << marriott_customer_info->children
+			<< customer_query->country << " @ "
+			<< customer_query->city << "  from "
+			<< customer_query->from_date << "  to "
+			<< customer_query->to_date << " ("
+			<< customer_query->number_of_nights << ")\n"
+			<< "\t\tAdults: " << customer_query->adults
+			<< "\n\t\tChildren: " << customer_query->children
 			<< "\n\t\tRoom Cost For ALl Nights: "
 			<< MarriottHotelReservation::getCost() << "\n";
 }
 
+ProviderId MarriottHotelReservation::providerId() {
+	static const ProviderId id = ProviderRegistry::instance().intern("Marriott");
+	return id;
+}
+
+SearchStats MarriottHotelReservation::searchStats() {
+	return marriottSearch().stats();
+}
+
 Reservation_ptr MarriottHotelReservation::clone() const {
 	return std::make_unique < MarriottHotelReservation > (*this);
 }
 
-bool MarriottHotelReservation::makeReservation() {
-	return MarriottHotelAPI::reserveRoom(*marriott_chosen_room,
-			*marriott_customer_info);
+void MarriottHotelReservation::reconcileAvailability(int rooms_taken) const {
+	std::string key = roomSearchKey(*customer_query);
+	const MarriottFoundRoom &chosen = marriott_chosen_room;
+	marriottSearch().cache().update(key,
+			[&](std::vector<MarriottFoundRoom> &rooms) {
+				for (auto &room : rooms)
+					if (room.room_type == chosen.room_type
+							&& room.date_from == chosen.date_from
+							&& room.date_to == chosen.date_to)
+						room.available_number = std::max(0,
+								room.available_number - rooms_taken);
+			});
 }
 
-bool MarriottHotelReservation::cancelReservation() {
-	return MarriottHotelAPI::cancelReservation(*marriott_chosen_room,
-			*marriott_customer_info);
+Task<bool> MarriottHotelReservation::makeReservationAsync(EventLoop &loop) {
+	Task<bool> booking = marriottLimiter().callAsync<bool>(loop, [this, &loop] {
+		return marriottMetrics().reserve.measureAsync<bool>([this, &loop] {
+			return MarriottHotelAPI::reserveRoomAsync(loop, marriott_chosen_room,
+					marriottRequest(*customer_query));
+		});
+	}, [] {
+		return false;
+	});
+	bool reserved = co_await booking;
+	if (!reserved)
+		co_return false;
+	//a reservation holds at least one room.
+	reconcileAvailability(std::max(1, customer_query->needed_rooms));
+	co_return true;
 }
 
-double MarriottHotelReservation::getCost() const {
-	return marriott_chosen_room->price_per_night
-			* marriott_customer_info->number_of_nights
-			* marriott_customer_info->needed_rooms;
+Task<bool> MarriottHotelReservation::cancelReservationAsync(EventLoop &loop) {
+	Task<bool> cancellation = marriottLimiter().callAsync<bool>(loop, [this, &loop] {
+		return marriottMetrics().cancel.measureAsync<bool>([this, &loop] {
+			return MarriottHotelAPI::cancelReservationAsync(loop, marriott_chosen_room,
+					marriottRequest(*customer_query));
+		});
+	}, [] {
+		return false;
+	});
+	bool cancelled = co_await cancellation;
+	if (!cancelled)
+		co_return false;
+	reconcileAvailability(-std::max(1, customer_query->needed_rooms));
+	co_return true;
 }
 
+Money MarriottHotelReservation::getCost() const {
+	return marriott_chosen_room.price_per_night
+			* customer_query->number_of_nights
+			* customer_query->needed_rooms;
+}
+
+//register both chains; MakeReservation only knows them through the registry.
+static const bool hilton_registered =
+		AdapterRegistry::instance().addHotelProvider(
+				HiltonHotelReservation::providerId(),
+				{ [] {
+					return std::make_unique<HiltonHotelReservation>();
+				}, [](CustomerQuery customer_info,
+						RoomInfo_ptr &&room) -> Reservation_ptr {
+					return std::make_unique<HiltonHotelReservation>(
+							std::move(customer_info), std::move(room));
+				}, HiltonHotelReservation::searchStats });
+
+static const bool marriott_registered =
+		AdapterRegistry::instance().addHotelProvider(
+				MarriottHotelReservation::providerId(),
+				{ [] {
+					return std::make_unique<MarriottHotelReservation>();
+				}, [](CustomerQuery customer_info,
+						RoomInfo_ptr &&room) -> Reservation_ptr {
+					return std::make_unique<MarriottHotelReservation>(
+							std::move(customer_info), std::move(room));
+				}, MarriottHotelReservation::searchStats });
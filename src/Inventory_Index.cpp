@@ -0,0 +1,73 @@
+/**
+ * @file Inventory_Index.cpp
+ * @brief Implements reading of provider inventory files
+ * @details Provides:
+ *          - Inventory directory lookup
+ *          - Comma separated line splitting with comment and blank line skipping
+ *          - Strict numeric field parsing
+ *
+ * @author Abdallah Salem
+ */
+#include "../include/Inventory_Index.hpp"
+#include <fstream>
+#include <cstdlib>
+#include <iostream>
+
+std::string inventoryPath(const std::string &file) {
+	const char *directory = std::getenv("EXPEDIA_INVENTORY_DIR");
+	std::string path = directory && *directory ? directory : "data";
+	return path + "/" + file;
+}
+
+/**
+ * @brief Splits a line on commas and trims every field.
+ */
+static std::vector<std::string> splitFields(const std::string &line) {
+	std::vector<std::string> fields;
+	std::size_t start = 0;
+	while (true) {
+		std::size_t comma = line.find(',', start);
+		std::string field = line.substr(start,
+				comma == std::string::npos ? std::string::npos : comma - start);
+		std::size_t first = field.find_first_not_of(" \t\r");
+		std::size_t last = field.find_last_not_of(" \t\r");
+		fields.push_back(
+				first == std::string::npos ?
+						"" : field.substr(first, last - first + 1));
+		if (comma == std::string::npos)
+			break;
+		start = comma + 1;
+	}
+	return fields;
+}
+
+bool readInventoryFile(const std::string &path,
+		const std::function<bool(const std::vector<std::string>&)> &row) {
+	std::ifstream file(path);
+	if (!file)
+		return false;
+	std::string line;
+	int line_number = 0;
+	while (std::getline(file, line)) {
+		line_number++;
+		std::size_t first = line.find_first_not_of(" \t\r");
+		if (first == std::string::npos || line[first] == '#')
+			continue;
+		if (!row(splitFields(line)))
+			std::cerr << path << ":" << line_number
+					<< ": malformed inventory line skipped\n";
+	}
+	return true;
+}
+
+bool parseInventoryNumber(const std::string &field, Money &value) {
+	return Money::parse(field, value);
+}
+
+bool parseInventoryNumber(const std::string &field, int &value) {
+	if (field.empty())
+		return false;
+	char *end = nullptr;
+	value = (int) std::strtol(field.c_str(), &end, 10);
+	return *end == '\0';
+}
@@ -5,57 +5,146 @@
  *          - Reservation collection management
  *          - Cost calculation for multi-reservation trips
  *          - Detailed output generation
+ *          - Copy-on-write sharing of the reservation list between copies
+ *          - Running totals, updated as reservations are added
+ *          - Cost, details and bookings visited over the inline reservation values
  *
  * @author Abdallah Salem
  */
 
 #include "../include/Itinerary.hpp"
+#include "../include/Itinerary_Commit.hpp"
+#include "../include/Flight_Reservation.hpp"
+#include "../include/Hotel_Reservation.hpp"
+#include <type_traits>
 
 Itinerary::~Itinerary() {
-	Reservations.clear();
+	Reservations.reset();
 }
 
-Itinerary::Itinerary(const Itinerary &other) {
-	for (const auto &reservation : other.Reservations)
-		addReservation(reservation);
+Itinerary::Itinerary(const Itinerary &other) :
+		Reservations(other.Reservations), total_cost(other.total_cost), flights_cost(
+				other.flights_cost), hotels_cost(other.hotels_cost) {
 }
 
 Itinerary::Itinerary(Itinerary &&other) :
-		Reservations(std::move(other.Reservations)) {
+		Reservations(std::move(other.Reservations)), total_cost(
+				other.total_cost), flights_cost(other.flights_cost), hotels_cost(
+				other.hotels_cost) {
+	other.clear();
 }
 
 Itinerary& Itinerary::operator=(Itinerary &other) {
 	if (this != &other) {
-		for (const auto &reservation : other.Reservations)
-			addReservation(reservation);
+		if (!Reservations) {
+			Reservations = other.Reservations;
+			total_cost = other.total_cost;
+			flights_cost = other.flights_cost;
+			hotels_cost = other.hotels_cost;
+		} else
+			for (const auto &reservation : other.reservations())
+				addReservation(reservation);
 	}
 	return *this;
 }
 
 Itinerary& Itinerary::operator=(Itinerary &&other) {
-	if (this != &other)
+	if (this != &other) {
 		Reservations = std::move(other.Reservations);
+		total_cost = other.total_cost;
+		flights_cost = other.flights_cost;
+		hotels_cost = other.hotels_cost;
+		other.clear();
+	}
 	return *this;
 }
 
-void Itinerary::addReservation(const Reservation_ptr &reservation) {
-	Reservations.push_back(reservation->clone());
+const std::vector<ReservationValue>& Itinerary::reservations() const {
+	static const std::vector<ReservationValue> none;
+	return Reservations ? *Reservations : none;
+}
+
+std::vector<ReservationValue>& Itinerary::ownReservations() {
+	//copy on write: only a list still shared with a copy is copied.
+	if (!Reservations)
+		Reservations = std::make_shared<std::vector<ReservationValue>>();
+	else if (Reservations.use_count() > 1)
+		Reservations = std::make_shared<std::vector<ReservationValue>>(
+				*Reservations);
+	return *Reservations;
+}
+
+void Itinerary::addCost(const ReservationValue &reservation) {
+	//reservations do not change once added, so neither does their cost.
+	Money cost = ::getCost(reservation);
+	total_cost += cost;
+	std::visit([this, &cost](const auto &kind) {
+		typedef std::decay_t<decltype(kind)> Kind;
+		if constexpr (std::is_base_of_v<FlightReservation, Kind>)
+			flights_cost += cost;
+		else if constexpr (std::is_base_of_v<HotelReservation, Kind>)
+			hotels_cost += cost;
+		else if (const Itinerary *trip = dynamic_cast<const Itinerary*>(kind.get())) {
+			flights_cost += trip->flights_cost;
+			hotels_cost += trip->hotels_cost;
+		} else if (dynamic_cast<const FlightReservation*>(kind.get()))
+			flights_cost += cost;
+		else if (dynamic_cast<const HotelReservation*>(kind.get()))
+			hotels_cost += cost;
+	}, reservation);
+}
+
+void Itinerary::addReservation(Reservation_ptr &&reservation) {
+	ReservationValue value = toValue(std::move(reservation));
+	Itinerary::addCost(value);
+	ownReservations().push_back(std::move(value));
+}
+
+void Itinerary::addReservation(const ReservationValue &reservation) {
+	Itinerary::addCost(reservation);
+	ownReservations().push_back(reservation);
 }
 
 void Itinerary::clear() {
-	Reservations.clear();
+	//copies sharing the list keep it.
+	Reservations.reset();
+	total_cost = flights_cost = hotels_cost = Money();
 }
 
 bool Itinerary::isEmpty() {
 	//return true if empty
-	if (Reservations.empty())
+	if (reservations().empty())
 		return true;
 	return false;
 }
 
-double Itinerary::getCost() const {
-	return (std::for_each(Reservations.begin(), Reservations.end(),
-			Sum<double>())).sum;
+Money Itinerary::getCost() const {
+	return total_cost;
+}
+
+Money Itinerary::getFlightsCost() const {
+	return flights_cost;
+}
+
+Money Itinerary::getHotelsCost() const {
+	return hotels_cost;
+}
+
+Task<bool> Itinerary::makeReservationAsync(EventLoop &loop) {
+	CommitOutcome outcome = co_await ItineraryCommit::commitAsync(loop, *this);
+	co_return outcome.committed();
+}
+
+Task<bool> Itinerary::cancelReservationAsync(EventLoop &loop) {
+	CommitOutcome outcome = co_await ItineraryCommit::cancelAsync(loop, *this);
+	co_return outcome.count(BookingState::STRANDED) == 0;
+}
+
+void Itinerary::appendBookings(std::vector<Reservation*> &bookings) {
+	if (!Reservations)
+		return;
+	for (ReservationValue &reservation : *Reservations)
+		::appendBookings(reservation, bookings);
 }
 
 Reservation_ptr Itinerary::clone() const {
@@ -64,10 +153,10 @@ Reservation_ptr Itinerary::clone() const {
 
 void Itinerary::getDetails(std::ostream &&get) const {
 	//collect data
-	get << "Itinerary of " << Itinerary::Reservations.size()
+	get << "Itinerary of " << reservations().size()
 			<< " sub-reservations: \n";
-	for (const auto &reservation : Itinerary::Reservations) {
-		reservation->getDetails(std::move(get));
+	for (const ReservationValue &reservation : reservations()) {
+		::getDetails(reservation, std::move(get));
 		std::cout << "\n";
 	}
 	get << "\nItinerary Cost: " << Itinerary::getCost();
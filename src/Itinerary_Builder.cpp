@@ -12,7 +12,7 @@
 
 ItineraryBuilder::ItineraryBuilder() :
 		it(std::make_unique<Itinerary>()), reserve(
-				std::make_unique<MakeReservation>()) {
+				std::make_unique<MakeReservation>(arena)) {
 
 }
 
@@ -20,18 +20,27 @@ void ItineraryBuilder::addFlight() {
 	auto reservation = reserve->reservingFlight();
 	if (!reservation)
 		return;
-	it->addReservation(reservation);
+	it->addReservation(std::move(reservation));
 }
 
 void ItineraryBuilder::addHotel() {
 	auto reservation = reserve->reservingRoom();
 	if (!reservation)
 		return;
-	it->addReservation(reservation);
+	it->addReservation(std::move(reservation));
+}
+
+void ItineraryBuilder::addConnectingFlight() {
+	auto reservation = reserve->reservingConnection();
+	if (!reservation)
+		return;
+	it->addReservation(std::move(reservation));
 }
 
 void ItineraryBuilder::clearItinerary() {
 	it->clear();   //reset the bag.
+	//the searches are over, nothing in the arena is alive.
+	arena.release();
 }
 
 bool ItineraryBuilder::checkItinerary() {
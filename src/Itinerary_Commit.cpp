@@ -0,0 +1,92 @@
+/**
+ * @file Itinerary_Commit.cpp
+ * @brief Implements parallel itinerary booking
+ * @details Provides:
+ *          - Concurrent provider calls for every booking on the event loop
+ *          - Compensation of partial commits
+ *
+ * @author Abdallah Salem
+ */
+#include "../include/Itinerary_Commit.hpp"
+
+bool CommitOutcome::committed() const {
+	return count(BookingState::BOOKED) == bookings.size();
+}
+
+std::size_t CommitOutcome::count(BookingState state) const {
+	return (std::size_t) std::count(bookings.begin(), bookings.end(), state);
+}
+
+/**
+ * @brief Awaits one provider call, counting an exception as a refusal.
+ */
+static Task<bool> attempt(Task<bool> call) {
+	try {
+		co_return co_await call;
+	} catch (...) {
+		co_return false;
+	}
+}
+
+Task<std::vector<bool>> ItineraryCommit::runAll(EventLoop &loop,
+		const std::vector<Reservation*> &bookings, bool book) {
+	std::vector<Task<bool>> calls;
+	calls.reserve(bookings.size());
+	for (Reservation *booking : bookings)
+		calls.push_back(
+				attempt(book ? booking->makeReservationAsync(loop) :
+								booking->cancelReservationAsync(loop)));
+	co_return co_await whenAll(loop, std::move(calls));
+}
+
+Task<CommitOutcome> ItineraryCommit::commitAsync(EventLoop &loop,
+		Reservation &reservation) {
+	std::vector<Reservation*> bookings;
+	reservation.appendBookings(bookings);
+	CommitOutcome outcome;
+	if (bookings.empty())
+		co_return outcome;
+	std::vector<bool> booked = co_await runAll(loop, bookings, true);
+	for (bool made : booked)
+		outcome.bookings.push_back(
+				made ? BookingState::BOOKED : BookingState::FAILED);
+	if (outcome.committed())
+		co_return outcome;
+	//undo the bookings that went through.
+	std::vector<Reservation*> undo;
+	std::vector<std::size_t> positions;
+	for (std::size_t i = 0; i < bookings.size(); i++)
+		if (booked[i]) {
+			undo.push_back(bookings[i]);
+			positions.push_back(i);
+		}
+	std::vector<bool> cancelled = co_await runAll(loop, undo, false);
+	for (std::size_t i = 0; i < undo.size(); i++)
+		outcome.bookings[positions[i]] =
+				cancelled[i] ? BookingState::COMPENSATED : BookingState::STRANDED;
+	co_return outcome;
+}
+
+Task<CommitOutcome> ItineraryCommit::cancelAsync(EventLoop &loop,
+		Reservation &reservation) {
+	std::vector<Reservation*> bookings;
+	reservation.appendBookings(bookings);
+	CommitOutcome outcome;
+	if (bookings.empty())
+		co_return outcome;
+	std::vector<bool> cancelled = co_await runAll(loop, bookings, false);
+	for (bool released : cancelled)
+		outcome.bookings.push_back(
+				released ? BookingState::COMPENSATED : BookingState::STRANDED);
+	co_return outcome;
+}
+
+CommitOutcome ItineraryCommit::commit(Reservation &reservation) {
+	return syncWait(EventLoop::instance(),
+			commitAsync(EventLoop::instance(), reservation));
+}
+
+CommitOutcome ItineraryCommit::cancel(Reservation &reservation) {
+	return syncWait(EventLoop::instance(),
+			cancelAsync(EventLoop::instance(), reservation));
+}
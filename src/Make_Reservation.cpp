@@ -4,107 +4,348 @@
  * @details Provides:
  *          - Flight/hotel reservation workflows
  *          - User input collection for reservations
- *          - Brand-specific reservation object creation
+ *          - Brand-specific reservation object creation through the adapter registry
+ *          - Concurrent provider searches with a per-search deadline
+ *          - Offers filtered by dates, price range and free rooms in each adapter's
+ *            result columns
+ *          - Ranking key (price, departure, check-in) chosen with every search
+ *          - First page rendered as provider answers stream in
+ *          - Connection search and booking of multi-leg trips
+ *          - Result lists allocated from the session arena, rewound at the start of
+ *            every search
+ *          - One chosen flight and room buffer reused by every search
  *
  * @author Abdallah Salem
  */
 
 #include "../include/Make_Reservation.hpp"
 
-MakeReservation::MakeReservation() :
-		passenger_info(nullptr), customer_info(nullptr), chosen_flight(nullptr), chosen_room(
-				nullptr) {
-	//reload APIs of brands
-	Airports.emplace_back(std::make_unique<CanadaFlightReservation>());
-	Airports.emplace_back(std::make_unique<TurkishFlightReservation>());
-	Hotels.emplace_back(std::make_unique<HiltonHotelReservation>());
-	Hotels.emplace_back(std::make_unique<MarriottHotelReservation>());
+/// Time a search waits for slow providers before showing partial results.
+static const std::chrono::milliseconds SEARCH_DEADLINE(2000);
 
+/// Number of results ranked and shown per page.
+static const std::size_t PAGE_SIZE = 10;
+
+/**
+ * @brief Prints one numbered flight result.
+ */
+static void printFlight(std::size_t number, const FoundFlightInfo &flight) {
+	std::cout << number << "- Airline: "
+			<< ProviderRegistry::instance().name(flight.airline) << " - Price: "
+			<< flight.price << " - Departure Date: "
+			<< flight.from_date << " - Arrival Date: " << flight.to_date << "\n";
 }
 
-Reservation_ptr MakeReservation::ReservationFactory(std::string &brand) {
-	//set the API according to the brand name.
-	if (brand == "Canada")
-		return std::make_unique < CanadaFlightReservation
-				> (std::move(passenger_info), std::move(chosen_flight));
-	else if (brand == "Turkish")
-		return std::make_unique < TurkishFlightReservation
-				> (std::move(passenger_info), std::move(chosen_flight));
-	else if (brand == "Hilton")
-		return std::make_unique < HiltonHotelReservation
-				> (std::move(customer_info), std::move(chosen_room));
-	else if (brand == "Marriott")
-		return std::make_unique < MarriottHotelReservation
-				> (std::move(customer_info), std::move(chosen_room));
-	return nullptr;
+/**
+ * @brief Prints one numbered room result.
+ */
+static void printRoom(std::size_t number, const FoundRoomInfo &room) {
+	std::cout << number << "- Hotel: "
+			<< ProviderRegistry::instance().name(room.hotel) << " - Price: "
+			<< room.price_for_night << " - Departure Date: "
+			<< room.from_date << " - Arrival Date: " << room.to_date << "\n";
+}
+
+/**
+ * @brief Reads the price range a search is limited to.
+ * @param lowest Receives the lowest price.
+ * @param highest Receives the highest price, zero for no limit.
+ * @return False if either price is not an amount.
+ */
+static bool readPriceRange(Money &lowest, Money &highest) {
+	std::string low, high;
+	std::cout << "\nPrice range, lowest and highest (0 0 for any): ";
+	std::cin >> low >> high;
+	return Money::parse(low, lowest) && Money::parse(high, highest);
+}
+
+/**
+ * @brief Adds a batch of streamed results behind those already shown.
+ * @details While the first page is not full, the best results of the batch (by the
+ *          ranking order) are printed right away and placed after the shown prefix of
+ *          the results; the rest of the batch is kept for later pages.
+ * @param results Shown results first, then the unshown ones.
+ * @param shown Number of results printed so far, advanced by the results printed.
+ * @param batch The newly arrived results.
+ * @param order The ranking order.
+ * @param print Prints one numbered result.
+ */
+template<typename Info, typename Print>
+static void showBatch(std::pmr::vector<Info> &results, std::size_t &shown,
+		std::vector<Info> &&batch,
+		const typename RankedResults<Info>::Order &order, Print print) {
+	std::size_t room_left = shown < PAGE_SIZE ? PAGE_SIZE - shown : 0;
+	std::size_t now = std::min(room_left, batch.size());
+	std::partial_sort(batch.begin(), batch.begin() + now, batch.end(), order);
+	for (std::size_t i = 0; i < now; i++)
+		print(shown + i + 1, batch[i]);
+	results.insert(results.begin() + shown,
+			std::make_move_iterator(batch.begin()),
+			std::make_move_iterator(batch.begin() + now));
+	results.insert(results.end(), std::make_move_iterator(batch.begin() + now),
+			std::make_move_iterator(batch.end()));
+	shown += now;
+}
+
+MakeReservation::MakeReservation(SessionArena &arena) :
+		passenger_info(nullptr), customer_info(nullptr), chosen_flight(
+				std::make_unique<FoundFlightInfo>()), chosen_room(
+				std::make_unique<FoundRoomInfo>()), search_pool(std::make_unique<WorkerPool>(4)), flight_search(
+				*search_pool, SEARCH_DEADLINE), room_search(*search_pool,
+				SEARCH_DEADLINE), arena(arena) {
+	//adapters of the enabled brands are built by the registry on first search.
+}
+
+Reservation_ptr MakeReservation::ReservationFactory(ProviderId provider) {
+	//dispatch on the brand ID found in the chosen result.
+	AdapterRegistry &registry = AdapterRegistry::instance();
+	if (registry.isFlightProvider(provider))
+		return registry.bookFlight(provider, passenger_info,
+				std::move(chosen_flight));
+	return registry.bookHotel(provider, customer_info, std::move(chosen_room));
 }
 
 Reservation_ptr MakeReservation::reservingFlight() {
-	passenger_info = std::make_unique<PassengerInfo>();
-	chosen_flight = std::make_unique<FoundFlightInfo>();
+	//the previous search's scratch died with it.
+	arena.release();
+	//the request and its shared count in one allocation.
+	auto request = std::make_shared<PassengerInfo>();
 	//get data from user
 	std::cout << "\nFrom Which Country: ";
-	std::cin >> passenger_info->from;
-	std::cout << "\nDisired Departure Date from  " << passenger_info->from
-			<< " : ";
-	std::cin >> passenger_info->from_date;
+	std::cin >> request->from;
+	std::string from_date, to_date;
+	std::cout << "\nDisired Departure Date from  " << request->from << " : ";
+	std::cin >> from_date;
 	std::cout << "\nTo Which Country: ";
-	std::cin >> passenger_info->to;
-	std::cout << "\nDate to " << passenger_info->to << " : ";
-	std::cin >> passenger_info->to_date;
+	std::cin >> request->to;
+	std::cout << "\nDate to " << request->to << " : ";
+	std::cin >> to_date;
 	std::cout << "\nEnter number of adults - children (5 - 16) and infants: ";
-	std::cin >> passenger_info->adults >> passenger_info->children
-			>> passenger_info->infants;
-	//get available flights from API
-	std::vector < FoundFlightInfo > available_flights;
-	for (const auto &airport : Airports)
-		airport->getAvailableFlights(std::move(available_flights));
-	for (const auto &flight : available_flights)
-		std::cout << "Airline: " + flight.airline << " - Price: "
-				<< std::to_string(flight.price) << " - Departure Date: "
-				<< flight.from_date + " - Arrival Date: "
-				<< flight.to_date + "\n";
+	std::cin >> request->adults >> request->children >> request->infants;
+	Money lowest, highest;
+	if (!readPriceRange(lowest, highest)) {
+		std::cout << "Invalid price, expected an amount such as 199.99.\n";
+		return nullptr;
+	}
+	int rank { };
+	std::cout << "\nSort by:\n1- Price.\n2- Departure.\n";
+	std::cin >> rank;
+	setFlightRanking(rank == 2 ? FlightRanking::DEPARTURE : FlightRanking::PRICE);
+	//dates are parsed once here and travel as day counts from now on.
+	request->from_date = Date::parse(from_date);
+	request->to_date = Date::parse(to_date);
+	if (!request->from_date.isValid() || !request->to_date.isValid()) {
+		std::cout << "Invalid date, expected dd-mm-yyyy.\n";
+		return nullptr;
+	}
+	//offers outside the dates or the price range are dropped by each airline's adapter.
+	FlightFilter filter = FlightFilter::forQuery(*request, lowest, highest);
+	if (Airports.empty())
+		Airports = AdapterRegistry::instance().makeFlightAdapters();
+	//query every airline at once; they all read the same request.
+	passenger_info = std::move(request);
+	//the first page is printed as the airlines answer, fastest first.
+	RankedResults<FoundFlightInfo>::Order order = flightOrder(flight_ranking);
+	std::pmr::vector < FoundFlightInfo > available_flights(arena.resource());
+	std::size_t shown { };
+	flight_search.stream(Airports,
+			[query = passenger_info, filter](FlightReservation &airport,
+					const FlightBatch &batch) {
+				airport.setCustomerInfo(query);
+				airport.streamAvailableFlights(filter, batch);
+			}, [&](std::vector<FoundFlightInfo> &&batch) {
+				showBatch(available_flights, shown, std::move(batch), order,
+						printFlight);
+			});
+	if (available_flights.empty()) {
+		std::cout << "No flights found on this route.\n";
+		return nullptr;
+	}
+	//rank the remaining pages one at a time, only on request.
+	RankedResults<FoundFlightInfo> ranked_flights(std::move(available_flights),
+			order, PAGE_SIZE, shown);
 	int choice { };
-	//print choices to the user.
-	std::cout << "Choose what suits you (-1 to cancel): \n";
-	std::cin >> choice;
-	if ((choice == -1) || (choice > (int) available_flights.size()))
+	while (true) {
+		//print choices to the user.
+		std::cout << "Choose what suits you (-1 to cancel"
+				<< (ranked_flights.hasNextPage() ? ", 0 for more" : "")
+				<< "): \n";
+		std::cin >> choice;
+		if (choice != 0 || !ranked_flights.hasNextPage())
+			break;
+		auto page = ranked_flights.nextPage();
+		for (std::size_t i = page.first; i < page.second; i++)
+			printFlight(i + 1, ranked_flights[i]);
+	}
+	if ((choice < 1) || (choice > (int) ranked_flights.rankedCount()))
 		return nullptr;
-	*chosen_flight = std::move(available_flights[choice - 1]);
+	*chosen_flight = ranked_flights.take(choice - 1);
 	return MakeReservation::ReservationFactory(chosen_flight->airline);
 }
 
 Reservation_ptr MakeReservation::reservingRoom() {
-	customer_info = std::make_unique<CustomerInfo>();
-	chosen_room = std::make_unique<FoundRoomInfo>();
+	//the previous search's scratch died with it.
+	arena.release();
+	auto request = std::make_shared<CustomerInfo>();
 	//get data from user.
 	std::cout << "\nCountry: ";
-	std::cin >> customer_info->country;
+	std::cin >> request->country;
 	std::cout << "\nCity: ";
-	std::cin >> customer_info->city;
+	std::cin >> request->city;
+	std::string from_date, to_date;
 	std::cout << "\nDate From: ";
-	std::cin >> customer_info->from_date;
+	std::cin >> from_date;
 	std::cout << "\nDate to: ";
-	std::cin >> customer_info->to_date;
+	std::cin >> to_date;
 	std::cout << "\nEnter Number of adults - children (5): ";
-	std::cin >> customer_info->adults >> customer_info->children;
+	std::cin >> request->adults >> request->children;
 	std::cout << "\nEnter Number Of desired Nights: ";
-	std::cin >> customer_info->number_of_nights;
-	std::vector < FoundRoomInfo > available_rooms;
-	//get available rooms from API.
-	for (const auto &hotel : Hotels)
-		hotel->getAvailableRooms(std::move(available_rooms));
-	for (const auto &room : available_rooms)
-		std::cout << "Hotel: " << room.hotel << " - Price: "
-				<< std::to_string(room.price_for_night) << " - Departure Date: "
-				<< room.from_date << " - Arrival Date: " << room.to_date + "\n";
-	//print data to the user.
+	std::cin >> request->number_of_nights;
+	Money lowest, highest;
+	if (!readPriceRange(lowest, highest)) {
+		std::cout << "Invalid price, expected an amount such as 199.99.\n";
+		return nullptr;
+	}
+	int rank { };
+	std::cout << "\nSort by:\n1- Price per night.\n2- Check-in date.\n";
+	std::cin >> rank;
+	setRoomRanking(rank == 2 ? RoomRanking::CHECK_IN : RoomRanking::PRICE_PER_NIGHT);
+	//dates are parsed once here and travel as day counts from now on.
+	request->from_date = Date::parse(from_date);
+	request->to_date = Date::parse(to_date);
+	if (!request->from_date.isValid() || !request->to_date.isValid()) {
+		std::cout << "Invalid date, expected dd-mm-yyyy.\n";
+		return nullptr;
+	}
+	//rooms not free for the stay, too few or outside the price range are dropped by
+	//each chain's adapter.
+	RoomFilter filter = RoomFilter::forQuery(*request, lowest, highest);
+	if (Hotels.empty())
+		Hotels = AdapterRegistry::instance().makeHotelAdapters();
+	//query every hotel chain at once; they all read the same request.
+	customer_info = std::move(request);
+	//the first page is printed as the chains answer, fastest first.
+	RankedResults<FoundRoomInfo>::Order order = roomOrder(room_ranking);
+	std::pmr::vector < FoundRoomInfo > available_rooms(arena.resource());
+	std::size_t shown { };
+	room_search.stream(Hotels,
+			[query = customer_info, filter](HotelReservation &hotel,
+					const RoomBatch &batch) {
+				hotel.setCustomerInfo(query);
+				hotel.streamAvailableRooms(filter, batch);
+			}, [&](std::vector<FoundRoomInfo> &&batch) {
+				showBatch(available_rooms, shown, std::move(batch), order,
+						printRoom);
+			});
+	if (available_rooms.empty()) {
+		std::cout << "No rooms found in this city.\n";
+		return nullptr;
+	}
+	//rank the remaining pages one at a time, only on request.
+	RankedResults<FoundRoomInfo> ranked_rooms(std::move(available_rooms), order,
+			PAGE_SIZE, shown);
 	int choice { };
-	std::cout << "Choose the suits you (-1 to cancel): \n";
-	std::cin >> choice;
-	if ((choice == -1) || (choice > (int) available_rooms.size()))
+	while (true) {
+		//print data to the user.
+		std::cout << "Choose the suits you (-1 to cancel"
+				<< (ranked_rooms.hasNextPage() ? ", 0 for more" : "") << "): \n";
+		std::cin >> choice;
+		if (choice != 0 || !ranked_rooms.hasNextPage())
+			break;
+		auto page = ranked_rooms.nextPage();
+		for (std::size_t i = page.first; i < page.second; i++)
+			printRoom(i + 1, ranked_rooms[i]);
+	}
+	if ((choice < 1) || (choice > (int) ranked_rooms.rankedCount()))
 		return nullptr;
-	*chosen_room = std::move(available_rooms[choice - 1]);
+	*chosen_room = ranked_rooms.take(choice - 1);
 	return MakeReservation::ReservationFactory(chosen_room->hotel);
 }
 
+Reservation_ptr MakeReservation::reservingConnection() {
+	//the previous search's scratch died with it.
+	arena.release();
+	PassengerInfo query;
+	std::string date;
+	int max_stops { }, goal { };
+	//get data from user
+	std::cout << "\nFrom Which Country: ";
+	std::cin >> query.from;
+	std::cout << "\nDisired Departure Date from  " << query.from << " : ";
+	std::cin >> date;
+	std::cout << "\nTo Which Country: ";
+	std::cin >> query.to;
+	std::cout << "\nEnter number of adults - children (5 - 16) and infants: ";
+	std::cin >> query.adults >> query.children >> query.infants;
+	std::cout << "\nMaximum number of stops: ";
+	std::cin >> max_stops;
+	std::cout << "\n1- Cheapest.\n2- Fastest.\n";
+	std::cin >> goal;
+	Date day = Date::parse(date);
+	if (!day.isValid()) {
+		std::cout << "Invalid date, expected dd-mm-yyyy.\n";
+		return nullptr;
+	}
+	if (!connections) {
+		std::vector<FlightLeg> legs;
+		AdapterRegistry::instance().appendInventoryLegs(legs);
+		connections = std::make_unique<ConnectionSearch>(std::move(legs));
+	}
+	//any departure on the chosen day.
+	DateTime earliest(day);
+	DateTime latest(earliest.minuteNumber() + DateTime::MINUTES_PER_DAY - 1);
+	std::vector<Connection> found = connections->search(query.from, query.to,
+			earliest, latest, max_stops,
+			goal == 2 ? ConnectionGoal::FASTEST : ConnectionGoal::CHEAPEST,
+			PAGE_SIZE);
+	if (found.empty()) {
+		std::cout << "No connections found on this route.\n";
+		return nullptr;
+	}
+	for (std::size_t i = 0; i < found.size(); i++) {
+		std::cout << i + 1 << "- Price: " << found[i].price
+				<< " - Duration: " << found[i].minutes / 60 << "h "
+				<< found[i].minutes % 60 << "m - Stops: "
+				<< found[i].legs.size() - 1 << "\n";
+		for (std::uint32_t index : found[i].legs) {
+			const FlightLeg &leg = connections->leg(index);
+			std::cout << "     Airline: "
+					<< ProviderRegistry::instance().name(leg.airline)
+					<< " - From: " << leg.from << " - To: " << leg.to
+					<< " - Departure Date: " << leg.departure
+					<< " - Arrival Date: " << leg.arrival << "\n";
+		}
+	}
+	int choice { };
+	std::cout << "Choose what suits you (-1 to cancel): \n";
+	std::cin >> choice;
+	if ((choice < 1) || (choice > (int) found.size()))
+		return nullptr;
+	//one flight reservation per leg, each with its own airline.
+	Itinerary_ptr trip = std::make_unique<Itinerary>();
+	for (std::uint32_t index : found[choice - 1].legs) {
+		const FlightLeg &leg = connections->leg(index);
+		auto request = std::make_shared<PassengerInfo>(query);
+		request->from = leg.from;
+		request->to = leg.to;
+		request->from_date = leg.departure.date();
+		request->to_date = leg.arrival.date();
+		passenger_info = std::move(request);
+		*chosen_flight = { leg.airline, leg.price, leg.departure, leg.arrival };
+		Reservation_ptr flight = MakeReservation::ReservationFactory(
+				leg.airline);
+		if (!flight)
+			return nullptr;
+		trip->addReservation(std::move(flight));
+	}
+	return trip;
+}
+
+void MakeReservation::setFlightRanking(FlightRanking key) {
+	flight_ranking = key;
+}
+
+void MakeReservation::setRoomRanking(RoomRanking key) {
+	room_ranking = key;
+}
+
@@ -0,0 +1,214 @@
+/**
+ * @file Mapped_Inventory.cpp
+ * @brief Implements the binary provider inventory files
+ * @details Provides:
+ *          - Mapping and validation of inventory files
+ *          - Key lookup over the sorted bucket table
+ *          - Sorting, bucketing and writing of new inventory files
+ *
+ * @author Abdallah Salem
+ */
+#include "../include/Mapped_Inventory.hpp"
+#include <fstream>
+#include <cstring>
+#include <algorithm>
+#ifdef _WIN32
+#include <iterator>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+/// Magic string at the start of every inventory file.
+static const char INVENTORY_MAGIC[8] = "EXPINV2";
+
+/**
+ * @brief Builds the bucket key of a pair of terms, as InventoryIndex does.
+ */
+static std::string inventoryKey(const std::string &first,
+		const std::string &second) {
+	return normalizeSearchText(first) + "|" + normalizeSearchText(second);
+}
+
+MappedInventory::MappedInventory(const std::string &path) {
+#ifdef _WIN32
+	std::ifstream file(path, std::ios::binary);
+	if (!file)
+		return;
+	copy.assign(std::istreambuf_iterator<char>(file),
+			std::istreambuf_iterator<char>());
+	data = copy.data();
+	length = copy.size();
+#else
+	int file = ::open(path.c_str(), O_RDONLY);
+	if (file < 0)
+		return;
+	struct stat status;
+	if (::fstat(file, &status) == 0 && status.st_size > 0) {
+		void *mapping = ::mmap(nullptr, (std::size_t) status.st_size, PROT_READ,
+				MAP_SHARED, file, 0);
+		if (mapping != MAP_FAILED) {
+			data = (const char*) mapping;
+			length = (std::size_t) status.st_size;
+		}
+	}
+	//the mapping stays valid once the descriptor is closed.
+	::close(file);
+#endif
+	if (data && !validate())
+		close();
+}
+
+MappedInventory::~MappedInventory() {
+	close();
+}
+
+void MappedInventory::close() {
+#ifndef _WIN32
+	if (data && copy.empty())
+		::munmap((void*) data, length);
+#endif
+	copy.clear();
+	data = nullptr;
+	length = 0;
+	header = InventoryFileHeader { };
+}
+
+bool MappedInventory::validate() {
+	if (length < sizeof(InventoryFileHeader))
+		return false;
+	std::memcpy(&header, data, sizeof(header));
+	if (std::memcmp(header.magic, INVENTORY_MAGIC, sizeof(INVENTORY_MAGIC)) != 0)
+		return false;
+	std::size_t bucket_bytes = (std::size_t) header.buckets
+			* sizeof(InventoryBucket);
+	std::size_t record_bytes = (std::size_t) header.records
+			* sizeof(InventoryRecord);
+	if (length
+			!= sizeof(InventoryFileHeader) + bucket_bytes + record_bytes
+					+ header.strings || header.strings == 0)
+		return false;
+	buckets = (const InventoryBucket*) (data + sizeof(InventoryFileHeader));
+	records = (const InventoryRecord*) (data + sizeof(InventoryFileHeader)
+			+ bucket_bytes);
+	strings = data + sizeof(InventoryFileHeader) + bucket_bytes + record_bytes;
+	//every string must end inside the table so text() never runs off the mapping.
+	if (strings[header.strings - 1] != '\0')
+		return false;
+	std::size_t filed = 0;
+	for (std::uint32_t i = 0; i < header.buckets; i++) {
+		const InventoryBucket &bucket = buckets[i];
+		if (bucket.key >= header.strings || bucket.first != filed
+				|| bucket.records > header.records - filed)
+			return false;
+		if (i > 0 && std::strcmp(text(buckets[i - 1].key), text(bucket.key)) >= 0)
+			return false;
+		filed += bucket.records;
+	}
+	if (filed != header.records)
+		return false;
+	for (std::uint32_t i = 0; i < header.records; i++)
+		if (records[i].first >= header.strings
+				|| records[i].second >= header.strings
+				|| records[i].label >= header.strings)
+			return false;
+	return true;
+}
+
+std::pair<const InventoryRecord*, const InventoryRecord*> MappedInventory::find(
+		const std::string &first, const std::string &second) const {
+	if (!data)
+		return {nullptr, nullptr};
+	std::string key = inventoryKey(first, second);
+	const InventoryBucket *end = buckets + header.buckets;
+	const InventoryBucket *found = std::lower_bound(buckets, end, key,
+			[this](const InventoryBucket &bucket, const std::string &key) {
+				return std::strcmp(text(bucket.key), key.c_str()) < 0;
+			});
+	if (found == end || key != text(found->key))
+		return {records, records};
+	return {records + found->first, records + found->first + found->records};
+}
+
+void MappedInventory::forEach(
+		const std::function<void(const InventoryRecord&)> &visit) const {
+	for (std::uint32_t i = 0; i < header.records; i++)
+		visit(records[i]);
+}
+
+InventoryFileWriter::InventoryFileWriter() {
+	//offset 0 is the empty string, used for missing labels.
+	intern("");
+}
+
+std::uint32_t InventoryFileWriter::intern(const std::string &text) {
+	auto found = interned.find(text);
+	if (found != interned.end())
+		return found->second;
+	std::uint32_t offset = (std::uint32_t) strings.size();
+	strings.append(text).push_back('\0');
+	interned.emplace(text, offset);
+	return offset;
+}
+
+void InventoryFileWriter::add(const std::string &first,
+		const std::string &second, const std::string &label, int count,
+		std::int32_t from, std::int32_t to, const Money &price) {
+	InventoryRecord record { };
+	record.first = intern(first);
+	record.second = intern(second);
+	record.label = intern(label);
+	record.count = count;
+	record.from = from;
+	record.to = to;
+	record.price = price.minorUnits();
+	rows.emplace_back(inventoryKey(first, second), record);
+}
+
+bool InventoryFileWriter::write(const std::string &path) const {
+	//stable so offers under one key keep the order they were added in.
+	std::vector<std::pair<std::string, InventoryRecord>> sorted = rows;
+	std::stable_sort(sorted.begin(), sorted.end(),
+			[](const auto &left, const auto &right) {
+				return std::strcmp(left.first.c_str(), right.first.c_str()) < 0;
+			});
+	std::string table = strings;
+	std::unordered_map<std::string, std::uint32_t> offsets = interned;
+	std::vector<InventoryBucket> buckets;
+	std::vector<InventoryRecord> records;
+	records.reserve(sorted.size());
+	for (const auto &row : sorted) {
+		if (buckets.empty() || row.first != table.c_str() + buckets.back().key) {
+			auto found = offsets.find(row.first);
+			std::uint32_t key;
+			if (found != offsets.end())
+				key = found->second;
+			else {
+				key = (std::uint32_t) table.size();
+				table.append(row.first).push_back('\0');
+				offsets.emplace(row.first, key);
+			}
+			buckets.push_back(
+					InventoryBucket { key, (std::uint32_t) records.size(), 0, 0 });
+		}
+		buckets.back().records++;
+		records.push_back(row.second);
+	}
+	InventoryFileHeader header { };
+	std::memcpy(header.magic, INVENTORY_MAGIC, sizeof(INVENTORY_MAGIC));
+	header.buckets = (std::uint32_t) buckets.size();
+	header.records = (std::uint32_t) records.size();
+	header.strings = (std::uint32_t) table.size();
+	std::ofstream file(path, std::ios::binary | std::ios::trunc);
+	if (!file)
+		return false;
+	file.write((const char*) &header, sizeof(header));
+	file.write((const char*) buckets.data(),
+			(std::streamsize) (buckets.size() * sizeof(InventoryBucket)));
+	file.write((const char*) records.data(),
+			(std::streamsize) (records.size() * sizeof(InventoryRecord)));
+	file.write(table.data(), (std::streamsize) table.size());
+	return (bool) file;
+}
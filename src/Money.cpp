@@ -0,0 +1,156 @@
+/**
+ * @file Money.cpp
+ * @brief Implements exact money amounts
+ * @details Provides:
+ *          - Exact parsing of decimal amounts
+ *          - Currency checks on arithmetic and comparisons
+ *          - Output in major units
+ *
+ * @author Abdallah Salem
+ */
+#include "../include/Money.hpp"
+#include <cmath>
+#include <cctype>
+#include <limits>
+
+/**
+ * @brief Gets a currency code as text.
+ */
+static std::string codeText(const CurrencyCode &code) {
+	return std::string(code.data());
+}
+
+CurrencyMismatch::CurrencyMismatch(const CurrencyCode &left,
+		const CurrencyCode &right) :
+		std::logic_error(
+				"amounts in " + codeText(left) + " and " + codeText(right)
+						+ " cannot be combined") {
+}
+
+CurrencyCode Money::defaultCurrency() {
+	return {'U', 'S', 'D', '\0'};
+}
+
+CurrencyCode Money::currencyCode(const std::string &code) {
+	CurrencyCode currency { };
+	for (std::size_t i = 0; i < 3 && i < code.size(); i++)
+		currency[i] = (char) std::toupper((unsigned char) code[i]);
+	return currency;
+}
+
+Money::Money() :
+		code(defaultCurrency()) {
+}
+
+Money::Money(std::int64_t minor_units, CurrencyCode currency) :
+		minor_units(minor_units), code(currency) {
+}
+
+Money Money::fromMajor(double amount, CurrencyCode currency) {
+	return Money((std::int64_t) std::llround(amount * (double) MINOR_PER_MAJOR),
+			currency);
+}
+
+bool Money::parse(const std::string &text, Money &money,
+		CurrencyCode currency) {
+	std::size_t i = 0;
+	bool negative = i < text.size() && text[i] == '-';
+	if (negative || (i < text.size() && text[i] == '+'))
+		i++;
+	//largest whole part whose cents still fit.
+	const std::int64_t max_major = (std::numeric_limits<std::int64_t>::max()
+			- (MINOR_PER_MAJOR - 1)) / MINOR_PER_MAJOR;
+	std::int64_t major { }, minor { };
+	std::size_t digits { };
+	for (; i < text.size() && std::isdigit((unsigned char) text[i]); i++, digits++) {
+		int digit = text[i] - '0';
+		if (major > (max_major - digit) / 10)
+			return false;
+		major = major * 10 + digit;
+	}
+	if (i < text.size() && text[i] == '.') {
+		i++;
+		//at most two decimals: cents are the smallest unit.
+		std::int64_t scale = MINOR_PER_MAJOR;
+		for (; i < text.size() && std::isdigit((unsigned char) text[i]); i++, digits++) {
+			scale /= 10;
+			if (scale == 0)
+				return false;
+			minor += (text[i] - '0') * scale;
+		}
+	}
+	if (digits == 0 || i != text.size())
+		return false;
+	std::int64_t units = major * MINOR_PER_MAJOR + minor;
+	money = Money(negative ? -units : units, currency);
+	return true;
+}
+
+std::int64_t Money::minorUnits() const {
+	return minor_units;
+}
+
+const CurrencyCode& Money::currency() const {
+	return code;
+}
+
+std::string Money::currencyName() const {
+	return codeText(code);
+}
+
+double Money::toMajor() const {
+	return (double) minor_units / (double) MINOR_PER_MAJOR;
+}
+
+bool Money::isZero() const {
+	return minor_units == 0;
+}
+
+void Money::matchCurrency(const Money &other) {
+	if (code == other.code || other.minor_units == 0)
+		return;
+	if (minor_units != 0)
+		throw CurrencyMismatch(code, other.code);
+	code = other.code;
+}
+
+Money& Money::operator+=(const Money &other) {
+	Money::matchCurrency(other);
+	minor_units += other.minor_units;
+	return *this;
+}
+
+Money& Money::operator-=(const Money &other) {
+	Money::matchCurrency(other);
+	minor_units -= other.minor_units;
+	return *this;
+}
+
+Money& Money::operator*=(std::int64_t count) {
+	minor_units *= count;
+	return *this;
+}
+
+bool Money::operator==(const Money &other) const {
+	return minor_units == other.minor_units
+			&& (code == other.code || minor_units == 0);
+}
+
+bool Money::operator<(const Money &other) const {
+	if (code != other.code && minor_units != 0 && other.minor_units != 0)
+		throw CurrencyMismatch(code, other.code);
+	return minor_units < other.minor_units;
+}
+
+std::ostream& operator<<(std::ostream &out, const Money &money) {
+	std::int64_t units = money.minorUnits();
+	if (units < 0) {
+		out << '-';
+		units = -units;
+	}
+	out << units / Money::MINOR_PER_MAJOR;
+	std::int64_t cents = units % Money::MINOR_PER_MAJOR;
+	if (cents != 0)
+		out << '.' << (char) ('0' + cents / 10) << (char) ('0' + cents % 10);
+	return out;
+}
@@ -5,12 +5,14 @@
  *          - PayPal payment processing
  *          - Stripe payment processing
  *          - Square payment processing
+ *          - Switching to the provider simulator when it is active
  *
  * @author Abdallah Salem
  */
 
 #include"../include/payment_APIs.hpp"
 #include"../include/json.hpp"
+#include"../include/Provider_Simulator.hpp"
 
 void PayPalOnlinePaymentAPI::setCardInfo(PayPalCreditCard_ptr &user) {
 	//data is sent to API and API set it.
@@ -21,18 +23,24 @@ void PayPalOnlinePaymentAPI::setUserInfo(PayPalCreditCard_ptr &user) {
 
 }
 
-bool PayPalOnlinePaymentAPI::makePayment(double money) {
+bool PayPalOnlinePaymentAPI::makePayment(const Money &money) {
+	if (ProviderSimulator::instance().isActive())
+		return ProviderSimulator::instance().call("PayPal");
 	//suppose the process is successfully done.
 	return true;
 }
 
 bool StripePaymentAPI::WithDrawMoney(StripeUserInfo_ptr &user,
-		StripeCardInfo_ptr &card, double money) {
+		StripeCardInfo_ptr &card, const Money &money) {
+	if (ProviderSimulator::instance().isActive())
+		return ProviderSimulator::instance().call("Stripe");
 	//suppose the process is successfully done.
 	return true;
 }
 
 bool SquarePaymentAPI::WithDrawMoney(std::string jsonQuery) {
+	if (ProviderSimulator::instance().isActive())
+		return ProviderSimulator::instance().call("Square");
 	//suppose withdraw is successfully done.
 	json::JSON query = json::JSON::Load(jsonQuery);
 	return true;
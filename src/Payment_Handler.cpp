@@ -58,7 +58,8 @@ bool PaymentHandler::setTransactionInfo() {
 	return true;
 }
 
-bool PaymentHandler::makeThePayment() {
+bool PaymentHandler::makeThePayment(const Money &amount) {
+	Trans_Info->money = amount;
 	//call API to make the Payment.
 	return Pay->pay(Trans_Info);
 }
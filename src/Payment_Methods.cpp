@@ -5,11 +5,16 @@
  *          - PaypalPayment: PayPal API integration
  *          - StripePayment: Stripe API integration
  *          - SquarePayment: Square API integration
+ *          - Every API call goes through its provider's limiter, so a failing payment
+ *            service is refused at once instead of holding the checkout, and is timed
+ *            and counted in its provider's call metrics
  *
  * @author Abdallah Salem
  */
 #include"../include/payment_methods.hpp"
 #include"../include/json.hpp"
+#include"../include/Provider_Limiter.hpp"
+#include"../include/Provider_Metrics.hpp"
 #include<sstream>
 
 PaypalPayment::PaypalPayment() :
@@ -45,10 +50,18 @@ void PaypalPayment::setCardInfo(const TransactionInfo_ptr &trans_info) {
 	info->ccv = trans_info->ccv;
 }
 
-bool PaypalPayment::makePayment(double money) {
+bool PaypalPayment::makePayment(const Money &money) {
 	paypal->setCardInfo(info);
 	paypal->setUserInfo(info);
-	if (paypal->makePayment(money)) {
+	static CallMetrics &metrics = CallMetrics::forCall("PayPal", "payment");
+	bool paid = ProviderLimiter::forProvider("PayPal").call<bool>([&] {
+		return metrics.measure<bool>([&] {
+			return paypal->makePayment(money);
+		});
+	}, [] {
+		return false;
+	});
+	if (paid) {
 		std::cout << "Your Payment is successfully made.\n";
 		return true;
 	}
@@ -88,8 +101,16 @@ void StripePayment::setCardInfo(const TransactionInfo_ptr &trans_info) {
 	card->ccv = trans_info->ccv;
 }
 
-bool StripePayment::makePayment(double money) {
-	if (StripePaymentAPI::WithDrawMoney(user, card, money)) {
+bool StripePayment::makePayment(const Money &money) {
+	static CallMetrics &metrics = CallMetrics::forCall("Stripe", "payment");
+	bool paid = ProviderLimiter::forProvider("Stripe").call<bool>([&] {
+		return metrics.measure<bool>([&] {
+			return StripePaymentAPI::WithDrawMoney(user, card, money);
+		});
+	}, [] {
+		return false;
+	});
+	if (paid) {
 		std::cout << "Your Payment is successfully made.\n";
 		return true;
 	}
@@ -108,11 +129,20 @@ void SquarePayment::setCardInfo(const TransactionInfo_ptr &trans_info) {
 	query["card_info"]["expire_date"] = trans_info->expire_date;
 }
 
-bool SquarePayment::makePayment(double money) {
-	query["Payment_money"] = json::Array(money);
+bool SquarePayment::makePayment(const Money &money) {
+	query["Payment_money"] = json::Array(money.minorUnits(),
+			money.currencyName());
 	std::ostringstream str_query;
 	str_query << query;
-	if (SquarePaymentAPI::WithDrawMoney(str_query.str())) {
+	static CallMetrics &metrics = CallMetrics::forCall("Square", "payment");
+	bool paid = ProviderLimiter::forProvider("Square").call<bool>([&] {
+		return metrics.measure<bool>([&] {
+			return SquarePaymentAPI::WithDrawMoney(str_query.str());
+		});
+	}, [] {
+		return false;
+	});
+	if (paid) {
 		std::cout << "Your Payment is successfully made.\n";
 		return true;
 	}
@@ -0,0 +1,214 @@
+/**
+ * @file Provider_Limiter.cpp
+ * @brief Implements adaptive provider concurrency limits
+ * @details Provides:
+ *          - Slot admission, queueing and release, parking coroutines until a slot frees up
+ *          - AIMD limit adjustment and circuit breaker transitions
+ *          - The process-wide limiter of each provider
+ *
+ * @author Abdallah Salem
+ */
+#include "../include/Provider_Limiter.hpp"
+#include <list>
+#include <algorithm>
+
+/// Weight of a new latency in the recent average.
+static const double RECENT_WEIGHT = 0.2;
+/// Weight of a new latency in the long-run baseline.
+static const double BASELINE_WEIGHT = 0.01;
+
+std::ostream& operator<<(std::ostream &out, const LimiterStats &stats) {
+	static const char *STATES[] = { "closed", "open", "half-open" };
+	out << stats.provider << ": limit " << stats.limit << ", in flight "
+			<< stats.in_flight << ", queued " << stats.queued << ", breaker "
+			<< STATES[(int) stats.state] << ", admitted " << stats.admitted
+			<< ", rejected " << stats.rejected << ", failures " << stats.failures
+			<< ", trips " << stats.trips;
+	return out;
+}
+
+ProviderLimiter::ProviderLimiter(const std::string &provider,
+		const LimiterSettings &settings) :
+		provider(provider), settings(settings), limit(settings.initial_limit) {
+	counters.provider = provider;
+}
+
+/**
+ * @brief Limiters of every provider; a list so references stay valid as it grows.
+ * @details Never destroyed, so their stats can still be written when the program exits.
+ */
+static std::list<ProviderLimiter>& limiters(std::mutex *&guard) {
+	static std::mutex *lock = new std::mutex();
+	static std::list<ProviderLimiter> *all = new std::list<ProviderLimiter>();
+	guard = lock;
+	return *all;
+}
+
+ProviderLimiter& ProviderLimiter::forProvider(const std::string &provider) {
+	std::mutex *lock;
+	std::list<ProviderLimiter> &all = limiters(lock);
+	std::lock_guard<std::mutex> guard(*lock);
+	for (ProviderLimiter &limiter : all)
+		if (limiter.provider == provider)
+			return limiter;
+	return all.emplace_back(provider);
+}
+
+std::vector<LimiterStats> ProviderLimiter::allStats() {
+	std::mutex *lock;
+	std::list<ProviderLimiter> &all = limiters(lock);
+	std::lock_guard<std::mutex> guard(*lock);
+	std::vector<LimiterStats> stats;
+	for (const ProviderLimiter &limiter : all)
+		stats.push_back(limiter.stats());
+	return stats;
+}
+
+ProviderLimiter::Admission ProviderLimiter::admit() {
+	if (counters.state == BreakerState::OPEN) {
+		if (std::chrono::steady_clock::now() - opened_at < settings.open_time)
+			return Admission::REFUSED;
+		counters.state = BreakerState::HALF_OPEN;
+	}
+	//a half-open breaker lets a single probe through.
+	std::size_t slots =
+			counters.state == BreakerState::HALF_OPEN ?
+					1 : (std::size_t) limit;
+	if (counters.in_flight >= slots)
+		return Admission::FULL;
+	counters.in_flight++;
+	counters.admitted++;
+	return Admission::ADMITTED;
+}
+
+bool ProviderLimiter::acquire() {
+	std::unique_lock<std::mutex> guard(lock);
+	Admission admission = admit();
+	if (admission == Admission::FULL) {
+		counters.queued++;
+		room.wait_for(guard, settings.queue_timeout, [&] {
+			admission = admit();
+			return admission != Admission::FULL;
+		});
+		counters.queued--;
+	}
+	if (admission != Admission::ADMITTED) {
+		counters.rejected++;
+		return false;
+	}
+	return true;
+}
+
+bool ProviderLimiter::SlotWait::await_suspend(
+		std::coroutine_handle<> awaiting) {
+	std::shared_ptr<SlotWaiter> parked = std::make_shared<SlotWaiter>();
+	ProviderLimiter &owner = limiter;
+	EventLoop &timer_loop = loop;
+	auto due = deadline;
+	{
+		std::lock_guard<std::mutex> guard(owner.lock);
+		admission = owner.admit();
+		if (admission != Admission::FULL)
+			return false;
+		parked->loop = &loop;
+		parked->waiting = awaiting;
+		owner.waiters.push_back(parked);
+		owner.counters.queued++;
+		waiter = parked;
+	}
+	//a release may already have resumed the awaiting coroutine; only locals from here.
+	owner.expireWaiter(timer_loop, due, std::move(parked));
+	return true;
+}
+
+Task<bool> ProviderLimiter::acquireAsync(EventLoop &loop) {
+	SlotWait wait { *this, loop, std::chrono::steady_clock::now()
+			+ settings.queue_timeout, Admission::FULL, nullptr };
+	Admission admission = co_await wait;
+	if (admission != Admission::ADMITTED) {
+		std::lock_guard<std::mutex> guard(lock);
+		counters.rejected++;
+		co_return false;
+	}
+	co_return true;
+}
+
+void ProviderLimiter::wakeWaiters(
+		std::vector<std::shared_ptr<SlotWaiter>> &woken) {
+	while (!waiters.empty()) {
+		Admission admission = admit();
+		if (admission == Admission::FULL)
+			break;
+		std::shared_ptr<SlotWaiter> waiter = std::move(waiters.front());
+		waiters.pop_front();
+		counters.queued--;
+		waiter->admission = admission;
+		waiter->woken = true;
+		woken.push_back(std::move(waiter));
+	}
+}
+
+Detached ProviderLimiter::expireWaiter(EventLoop &loop,
+		std::chrono::steady_clock::time_point deadline,
+		std::shared_ptr<SlotWaiter> waiter) {
+	EventLoop::Sleep timeout { loop, deadline };
+	co_await timeout;
+	bool expired = false;
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		if (!waiter->woken) {
+			waiter->woken = true;
+			expired = true;
+			waiters.erase(std::find(waiters.begin(), waiters.end(), waiter));
+			counters.queued--;
+		}
+	}
+	if (expired)
+		waiter->loop->post(waiter->waiting);
+}
+
+void ProviderLimiter::release(std::chrono::microseconds latency,
+		bool succeeded) {
+	std::vector<std::shared_ptr<SlotWaiter>> woken;
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		counters.in_flight--;
+		if (succeeded) {
+			consecutive_failures = 0;
+			if (counters.state == BreakerState::HALF_OPEN)
+				counters.state = BreakerState::CLOSED;
+			double taken = (double) latency.count();
+			//a single slow answer is the tail, not congestion; compare averages.
+			if (baseline == 0)
+				baseline = recent = taken;
+			recent += (taken - recent) * RECENT_WEIGHT;
+			baseline += (taken - baseline) * BASELINE_WEIGHT;
+			if (recent <= settings.latency_tolerance * baseline)
+				limit = std::min(settings.max_limit, limit + 1 / limit);
+			else
+				limit = std::max(settings.min_limit, limit * settings.backoff);
+		} else {
+			counters.failures++;
+			limit = std::max(settings.min_limit, limit * settings.backoff);
+			if (counters.state == BreakerState::HALF_OPEN
+					|| ++consecutive_failures >= settings.failure_threshold) {
+				if (counters.state != BreakerState::OPEN)
+					counters.trips++;
+				counters.state = BreakerState::OPEN;
+				opened_at = std::chrono::steady_clock::now();
+				consecutive_failures = 0;
+			}
+		}
+		wakeWaiters(woken);
+	}
+	room.notify_all();
+	for (const std::shared_ptr<SlotWaiter> &waiter : woken)
+		waiter->loop->post(waiter->waiting);
+}
+
+LimiterStats ProviderLimiter::stats() const {
+	std::lock_guard<std::mutex> guard(lock);
+	LimiterStats snapshot = counters;
+	snapshot.limit = (std::size_t) limit;
+	return snapshot;
+}
@@ -0,0 +1,312 @@
+/**
+ * @file Provider_Metrics.cpp
+ * @brief Implements provider call accounting
+ * @details Provides:
+ *          - Log-linear bucketing and percentiles
+ *          - Per-thread counters, written by their thread alone without locks and retired
+ *            when it exits
+ *          - Snapshots adding up every thread, and the dump at exit
+ *
+ * @author Abdallah Salem
+ */
+#include "../include/Provider_Metrics.hpp"
+#include <bit>
+#include <list>
+#include <mutex>
+#include <atomic>
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+
+/// Most operations that can be measured; slots are reserved in every thread.
+static const std::size_t MAX_OPERATIONS = 64;
+/// Buckets below the first split power of two.
+static const std::size_t LINEAR_BUCKETS = 16;
+/// log2 of the number of buckets each power of two is split into.
+static const unsigned SUB_BUCKET_BITS = 4;
+
+std::size_t ValueHistogram::bucketOf(std::uint64_t value) {
+	if (value < LINEAR_BUCKETS)
+		return (std::size_t) value;
+	unsigned exponent = (unsigned) std::bit_width(value) - 1;
+	std::size_t sub = (std::size_t) (value >> (exponent - SUB_BUCKET_BITS))
+			- LINEAR_BUCKETS;
+	std::size_t bucket = LINEAR_BUCKETS
+			+ (exponent - SUB_BUCKET_BITS) * LINEAR_BUCKETS + sub;
+	return bucket < BUCKETS ? bucket : BUCKETS - 1;
+}
+
+std::uint64_t ValueHistogram::bucketLimit(std::size_t bucket) {
+	if (bucket < LINEAR_BUCKETS)
+		return bucket;
+	unsigned shift = (unsigned) ((bucket - LINEAR_BUCKETS) / LINEAR_BUCKETS);
+	std::uint64_t sub = (bucket - LINEAR_BUCKETS) % LINEAR_BUCKETS;
+	return ((LINEAR_BUCKETS + sub + 1) << shift) - 1;
+}
+
+std::uint64_t ValueHistogram::count() const {
+	std::uint64_t total = 0;
+	for (std::uint64_t bucket : counts)
+		total += bucket;
+	return total;
+}
+
+std::uint64_t ValueHistogram::percentile(double fraction) const {
+	std::uint64_t total = count();
+	if (total == 0)
+		return 0;
+	//rank of the percentile, 1-based.
+	std::uint64_t rank = (std::uint64_t) (fraction * (double) (total - 1)) + 1;
+	std::uint64_t seen = 0;
+	for (std::size_t bucket = 0; bucket < BUCKETS; bucket++) {
+		seen += counts[bucket];
+		if (seen >= rank)
+			return bucketLimit(bucket);
+	}
+	return bucketLimit(BUCKETS - 1);
+}
+
+const std::size_t CallMetrics::UNRECORDED = MAX_OPERATIONS;
+
+std::ostream& operator<<(std::ostream &out, const CallStats &stats) {
+	if (!stats.recorded)
+		return out << stats.provider << " " << stats.operation
+				<< ": not recorded, past the " << MAX_OPERATIONS
+				<< " measured operations";
+	out << stats.provider << " " << stats.operation << ": calls " << stats.calls
+			<< ", failures " << stats.failures << ", timeouts " << stats.timeouts
+			<< ", latency us p50 " << stats.latency.percentile(0.5) << " p90 "
+			<< stats.latency.percentile(0.9) << " p99 "
+			<< stats.latency.percentile(0.99) << " max "
+			<< stats.latency.percentile(1);
+	if (stats.results.count() > 0)
+		out << ", results p50 " << stats.results.percentile(0.5) << " max "
+				<< stats.results.percentile(1);
+	return out;
+}
+
+/**
+ * @class OperationCounters
+ * @brief One thread's counters of one operation.
+ * @details Only the owning thread writes them, with plain relaxed loads and stores; the
+ *          atomics only let snapshots read them while they are written.
+ */
+class OperationCounters {
+public:
+	std::atomic<std::uint64_t> calls { };    ///< Calls made.
+	std::atomic<std::uint64_t> failures { }; ///< Calls that failed.
+	std::atomic<std::uint64_t> timeouts { }; ///< Calls that timed out.
+	std::array<std::atomic<std::uint64_t>, ValueHistogram::BUCKETS> latency { }; ///< Latency buckets.
+	std::array<std::atomic<std::uint64_t>, ValueHistogram::BUCKETS> results { }; ///< Result size buckets.
+};
+
+/**
+ * @class ThreadCounters
+ * @brief Counters of every operation recorded by one thread.
+ */
+class ThreadCounters {
+public:
+	/// Counters per operation slot, created the first time the thread records it.
+	std::array<std::atomic<OperationCounters*>, MAX_OPERATIONS> operations { };
+};
+
+/**
+ * @brief Adds one to a counter only the calling thread writes.
+ */
+static void bump(std::atomic<std::uint64_t> &counter) {
+	counter.store(counter.load(std::memory_order_relaxed) + 1,
+			std::memory_order_relaxed);
+}
+
+/**
+ * @brief Adds one operation's counters into a snapshot.
+ */
+static void addCounters(CallStats &snapshot, const OperationCounters &counters) {
+	snapshot.calls += counters.calls.load(std::memory_order_relaxed);
+	snapshot.failures += counters.failures.load(std::memory_order_relaxed);
+	snapshot.timeouts += counters.timeouts.load(std::memory_order_relaxed);
+	for (std::size_t bucket = 0; bucket < ValueHistogram::BUCKETS; bucket++) {
+		snapshot.latency.counts[bucket] += counters.latency[bucket].load(
+				std::memory_order_relaxed);
+		snapshot.results.counts[bucket] += counters.results[bucket].load(
+				std::memory_order_relaxed);
+	}
+}
+
+/**
+ * @class MetricsRegistry
+ * @brief Every operation, the counters of every live thread and those of exited ones.
+ * @details Never destroyed: threads still running while the program exits keep
+ *          recording into it.
+ */
+class MetricsRegistry {
+public:
+	/// Guards every member.
+	std::mutex lock;
+	/// Operations in creation order; a list so references stay valid as it grows.
+	std::list<CallMetrics> operations;
+	/// Counters of every live thread that recorded a call.
+	std::vector<ThreadCounters*> threads;
+	/// Totals per operation slot of the threads that have exited.
+	std::vector<CallStats> retired;
+};
+
+/**
+ * @brief Writes the snapshots and the limiters to the file named by EXPEDIA_CALL_METRICS.
+ */
+static void dumpAtExit() {
+	const char *path = std::getenv("EXPEDIA_CALL_METRICS");
+	std::ofstream file(path);
+	if (!file)
+		return;
+	CallMetrics::dump(file);
+	for (const LimiterStats &limiter : ProviderLimiter::allStats())
+		file << limiter << "\n";
+}
+
+/**
+ * @brief The registry, created on first use.
+ */
+static MetricsRegistry& registry() {
+	static MetricsRegistry *metrics = [] {
+		const char *path = std::getenv("EXPEDIA_CALL_METRICS");
+		if (path && *path)
+			std::atexit(dumpAtExit);
+		return new MetricsRegistry();
+	}();
+	return *metrics;
+}
+
+/**
+ * @class ThreadRegistration
+ * @brief Registers a thread's counters and retires them when the thread exits.
+ */
+class ThreadRegistration {
+public:
+	/// The thread's counters.
+	ThreadCounters *counters;
+
+	ThreadRegistration() :
+			counters(new ThreadCounters()) {
+		MetricsRegistry &metrics = registry();
+		std::lock_guard<std::mutex> guard(metrics.lock);
+		metrics.threads.push_back(counters);
+	}
+
+	/**
+	 * @brief Folds the counters into the retired totals and frees them.
+	 */
+	~ThreadRegistration() {
+		MetricsRegistry &metrics = registry();
+		std::lock_guard<std::mutex> guard(metrics.lock);
+		for (std::size_t id = 0; id < MAX_OPERATIONS; id++) {
+			OperationCounters *operation = counters->operations[id].load(
+					std::memory_order_relaxed);
+			if (!operation)
+				continue;
+			if (metrics.retired.size() <= id)
+				metrics.retired.resize(id + 1);
+			addCounters(metrics.retired[id], *operation);
+			delete operation;
+		}
+		metrics.threads.erase(
+				std::find(metrics.threads.begin(), metrics.threads.end(), counters));
+		delete counters;
+	}
+
+	ThreadRegistration(const ThreadRegistration &other) = delete;
+	ThreadRegistration& operator=(const ThreadRegistration &other) = delete;
+};
+
+/**
+ * @brief The calling thread's counters, registered the first time it records a call.
+ */
+static ThreadCounters& threadCounters() {
+	thread_local ThreadRegistration registration;
+	return *registration.counters;
+}
+
+CallMetrics::CallMetrics(std::size_t id, const std::string &provider,
+		const std::string &operation) :
+		id(id), provider(provider), operation(operation) {
+}
+
+CallMetrics& CallMetrics::forCall(const std::string &provider,
+		const std::string &operation) {
+	MetricsRegistry &metrics = registry();
+	std::lock_guard<std::mutex> guard(metrics.lock);
+	for (CallMetrics &existing : metrics.operations)
+		if (existing.provider == provider && existing.operation == operation)
+			return existing;
+	std::size_t id = metrics.operations.size();
+	if (id >= MAX_OPERATIONS) {
+		std::cerr << "call metrics: " << provider << " " << operation
+				<< " is not recorded, past the " << MAX_OPERATIONS
+				<< " measured operations\n";
+		id = UNRECORDED;
+	}
+	return metrics.operations.emplace_back(id, provider, operation);
+}
+
+std::vector<CallStats> CallMetrics::allStats() {
+	MetricsRegistry &metrics = registry();
+	std::vector<const CallMetrics*> operations;
+	{
+		std::lock_guard<std::mutex> guard(metrics.lock);
+		for (const CallMetrics &operation : metrics.operations)
+			operations.push_back(&operation);
+	}
+	std::vector<CallStats> stats;
+	for (const CallMetrics *operation : operations)
+		stats.push_back(operation->stats());
+	return stats;
+}
+
+void CallMetrics::dump(std::ostream &out) {
+	for (const CallStats &stats : allStats())
+		out << stats << "\n";
+}
+
+void CallMetrics::record(std::chrono::microseconds latency,
+		CallOutcome outcome, std::optional<std::size_t> results) {
+	if (id == UNRECORDED)
+		return;
+	std::atomic<OperationCounters*> &slot = threadCounters().operations[id];
+	OperationCounters *counters = slot.load(std::memory_order_relaxed);
+	if (!counters) {
+		counters = new OperationCounters();
+		slot.store(counters, std::memory_order_release);
+	}
+	bump(counters->calls);
+	if (outcome == CallOutcome::FAILED)
+		bump(counters->failures);
+	else if (outcome == CallOutcome::TIMED_OUT)
+		bump(counters->timeouts);
+	std::int64_t micros = latency.count();
+	bump(counters->latency[ValueHistogram::bucketOf(
+			micros > 0 ? (std::uint64_t) micros : 0)]);
+	if (results)
+		bump(counters->results[ValueHistogram::bucketOf(*results)]);
+}
+
+CallStats CallMetrics::stats() const {
+	CallStats snapshot;
+	if (id != UNRECORDED) {
+		MetricsRegistry &metrics = registry();
+		//held throughout, so no thread retires its counters while they are read.
+		std::lock_guard<std::mutex> guard(metrics.lock);
+		if (id < metrics.retired.size())
+			snapshot = metrics.retired[id];
+		for (ThreadCounters *thread : metrics.threads) {
+			const OperationCounters *counters = thread->operations[id].load(
+					std::memory_order_acquire);
+			if (counters)
+				addCounters(snapshot, *counters);
+		}
+	} else
+		snapshot.recorded = false;
+	snapshot.provider = provider;
+	snapshot.operation = operation;
+	return snapshot;
+}
@@ -0,0 +1,39 @@
+/**
+ * @file Provider_Registry.cpp
+ * @brief Implements interning of provider brand names
+ * @details Provides:
+ *          - Singleton access to the registry
+ *          - Name to ID assignment and reverse lookup
+ *
+ * @author Abdallah Salem
+ */
+#include "../include/Provider_Registry.hpp"
+
+ProviderRegistry& ProviderRegistry::instance() {
+	static ProviderRegistry registry;
+	return registry;
+}
+
+ProviderId ProviderRegistry::intern(const std::string &name) {
+	std::lock_guard<std::mutex> guard(lock);
+	auto found = ids.find(name);
+	if (found != ids.end())
+		return found->second;
+	ProviderId id = (ProviderId) names.size();
+	names.push_back(name);
+	ids.emplace(name, id);
+	return id;
+}
+
+const std::string& ProviderRegistry::name(ProviderId id) const {
+	static const std::string unknown;
+	std::lock_guard<std::mutex> guard(lock);
+	if (id >= names.size())
+		return unknown;
+	return names[id];
+}
+
+std::size_t ProviderRegistry::size() const {
+	std::lock_guard<std::mutex> guard(lock);
+	return names.size();
+}
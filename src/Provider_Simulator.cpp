@@ -0,0 +1,232 @@
+/**
+ * @file Provider_Simulator.cpp
+ * @brief Implements the simulated provider layer
+ * @details Provides:
+ *          - Profile file parsing
+ *          - Log-normal latency sampling, error draws and timeouts
+ *          - Blocking and coroutine calls over the same draws
+ *          - Deterministic generated flight and room inventory
+ *
+ * @author Abdallah Salem
+ */
+#include "../include/Provider_Simulator.hpp"
+#include <cmath>
+#include <thread>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+
+/// z-score of the 99th percentile of the standard normal distribution.
+static const double Z_99 = 2.3263;
+
+ProviderSimulator::ProviderSimulator() :
+		random(std::random_device { }()) {
+	const char *path = std::getenv("EXPEDIA_SIMULATOR");
+	if (!path || !*path)
+		return;
+	active = true;
+	load(path);
+}
+
+ProviderSimulator& ProviderSimulator::instance() {
+	static ProviderSimulator simulator;
+	return simulator;
+}
+
+void ProviderSimulator::load(const std::string &path) {
+	std::ifstream file(path);
+	if (!file) {
+		std::cerr << path << ": no simulator profiles, using defaults\n";
+		return;
+	}
+	std::string line;
+	while (std::getline(file, line)) {
+		std::istringstream fields(line);
+		std::string name, setting;
+		if (!(fields >> name) || name[0] == '#')
+			continue;
+		SimulationProfile profile =
+				name == "default" ? defaults : this->profile(name);
+		while (fields >> setting) {
+			std::size_t equals = setting.find('=');
+			std::string key = setting.substr(0, equals);
+			double value =
+					equals == std::string::npos ?
+							0 : std::atof(setting.c_str() + equals + 1);
+			if (key == "inventory")
+				profile.inventory = (std::size_t) value;
+			else if (key == "p50")
+				profile.p50_ms = value;
+			else if (key == "p99")
+				profile.p99_ms = value;
+			else if (key == "errors")
+				profile.error_rate = value;
+			else if (key == "timeout")
+				profile.timeout_ms = value;
+			else
+				std::cerr << path << ": unknown setting '" << setting << "'\n";
+		}
+		if (name == "default")
+			defaults = profile;
+		else
+			profiles[name] = profile;
+	}
+}
+
+bool ProviderSimulator::isActive() const {
+	return active;
+}
+
+const SimulationProfile& ProviderSimulator::profile(
+		const std::string &provider) const {
+	auto found = profiles.find(provider);
+	return found == profiles.end() ? defaults : found->second;
+}
+
+double ProviderSimulator::uniform() {
+	std::lock_guard<std::mutex> guard(random_lock);
+	return std::uniform_real_distribution<double>(0, 1)(random);
+}
+
+double ProviderSimulator::normal() {
+	std::lock_guard<std::mutex> guard(random_lock);
+	return std::normal_distribution<double>(0, 1)(random);
+}
+
+ProviderSimulator::Answer ProviderSimulator::draw(const std::string &provider,
+		std::chrono::microseconds &latency) {
+	const SimulationProfile &profile = this->profile(provider);
+	double latency_ms = 0;
+	if (profile.p50_ms > 0) {
+		//log-normal through the median and the 99th percentile.
+		double sigma =
+				profile.p99_ms > profile.p50_ms ?
+						std::log(profile.p99_ms / profile.p50_ms) / Z_99 : 0;
+		latency_ms = profile.p50_ms * std::exp(sigma * normal());
+	}
+	bool timed_out = profile.timeout_ms > 0 && latency_ms > profile.timeout_ms;
+	if (timed_out)
+		latency_ms = profile.timeout_ms;
+	latency = std::chrono::microseconds((long long) (latency_ms * 1000));
+	if (timed_out)
+		return Answer::TIMED_OUT;
+	return uniform() >= profile.error_rate ? Answer::ANSWERED : Answer::FAILED;
+}
+
+void ProviderSimulator::checkAnswer(const std::string &provider,
+		Answer answer) {
+	if (answer == Answer::TIMED_OUT)
+		throw ProviderTimeout(provider);
+	if (answer == Answer::FAILED)
+		throw ProviderUnavailable(provider);
+}
+
+bool ProviderSimulator::call(const std::string &provider) {
+	std::chrono::microseconds latency;
+	Answer answer = draw(provider, latency);
+	std::this_thread::sleep_for(latency);
+	return answer == Answer::ANSWERED;
+}
+
+Task<bool> ProviderSimulator::callAsync(EventLoop &loop, std::string provider) {
+	std::chrono::microseconds latency;
+	Answer answer = draw(provider, latency);
+	co_await loop.sleepFor(latency);
+	co_return answer == Answer::ANSWERED;
+}
+
+/**
+ * @brief Seeds the generator of a provider's answer to one request.
+ */
+static std::mt19937 requestGenerator(const std::string &provider,
+		const std::string &request) {
+	return std::mt19937((std::uint32_t) std::hash<std::string> { }(
+			provider + "|" + request));
+}
+
+std::vector<SimulatedFlight> ProviderSimulator::searchFlights(
+		const std::string &provider, const std::string &from,
+		const std::string &to, DateTime day) {
+	std::chrono::microseconds latency;
+	Answer answer = draw(provider, latency);
+	std::this_thread::sleep_for(latency);
+	checkAnswer(provider, answer);
+	return generateFlights(provider, from, to, day);
+}
+
+Task<std::vector<SimulatedFlight>> ProviderSimulator::searchFlightsAsync(
+		EventLoop &loop, std::string provider, std::string from,
+		std::string to, DateTime day) {
+	std::chrono::microseconds latency;
+	Answer answer = draw(provider, latency);
+	co_await loop.sleepFor(latency);
+	checkAnswer(provider, answer);
+	co_return generateFlights(provider, from, to, day);
+}
+
+std::vector<SimulatedFlight> ProviderSimulator::generateFlights(
+		const std::string &provider, const std::string &from,
+		const std::string &to, DateTime day) const {
+	std::mt19937 generate = requestGenerator(provider,
+			from + "|" + to + "|" + std::to_string(day.date().dayNumber()));
+	std::int32_t midnight = DateTime(day.date()).minuteNumber();
+	std::vector<SimulatedFlight> flights;
+	std::size_t count = profile(provider).inventory;
+	flights.reserve(count);
+	for (std::size_t i = 0; i < count; i++) {
+		std::int32_t departure = midnight
+				+ (std::int32_t) (generate() % DateTime::MINUTES_PER_DAY);
+		std::int32_t duration = 60 + (std::int32_t) (generate() % (15 * 60));
+		Money price((80 + (std::int64_t) (generate() % 1200))
+				* Money::MINOR_PER_MAJOR);
+		flights.push_back( { price, DateTime(departure), DateTime(
+				departure + duration) });
+	}
+	return flights;
+}
+
+std::vector<SimulatedRoom> ProviderSimulator::searchRooms(
+		const std::string &provider, const std::string &city, Date from,
+		Date to) {
+	std::chrono::microseconds latency;
+	Answer answer = draw(provider, latency);
+	std::this_thread::sleep_for(latency);
+	checkAnswer(provider, answer);
+	return generateRooms(provider, city, from, to);
+}
+
+Task<std::vector<SimulatedRoom>> ProviderSimulator::searchRoomsAsync(
+		EventLoop &loop, std::string provider, std::string city, Date from,
+		Date to) {
+	std::chrono::microseconds latency;
+	Answer answer = draw(provider, latency);
+	co_await loop.sleepFor(latency);
+	checkAnswer(provider, answer);
+	co_return generateRooms(provider, city, from, to);
+}
+
+std::vector<SimulatedRoom> ProviderSimulator::generateRooms(
+		const std::string &provider, const std::string &city, Date from,
+		Date to) const {
+	static const char *ROOM_TYPES[] = { "Interior View", "City View",
+			"Deluxe View", "Sea View", "Private View" };
+	std::mt19937 generate = requestGenerator(provider,
+			city + "|" + std::to_string(from.dayNumber()) + "|"
+					+ std::to_string(to.dayNumber()));
+	std::vector<SimulatedRoom> rooms;
+	std::size_t count = profile(provider).inventory;
+	rooms.reserve(count);
+	for (std::size_t i = 0; i < count; i++) {
+		//room types stay unique so bookings reconcile with a single offer.
+		std::string type = ROOM_TYPES[i % 5];
+		if (i >= 5)
+			type += " " + std::to_string(i / 5 + 1);
+		int available = 1 + (int) (generate() % 10);
+		Money price((60 + (std::int64_t) (generate() % 700))
+				* Money::MINOR_PER_MAJOR);
+		rooms.push_back( { type, available, price, from, to });
+	}
+	return rooms;
+}
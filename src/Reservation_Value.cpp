@@ -0,0 +1,76 @@
+/**
+ * @file Reservation_Value.cpp
+ * @brief Implements the value-typed reservations
+ * @details Provides:
+ *          - std::visit dispatch of cost, details and bookings
+ *          - Conversion of a booked reservation into a value
+ *
+ * @author Abdallah Salem
+ */
+#include "../include/Reservation_Value.hpp"
+
+/**
+ * @brief Gets the reservation of a kind held by value.
+ */
+template<typename Kind>
+static Kind& kindOf(Kind &kind) {
+	return kind;
+}
+
+/**
+ * @brief Gets a reservation held as a shared pointer.
+ */
+static Reservation& kindOf(const SharedReservation &shared) {
+	return *shared;
+}
+
+/**
+ * @brief Gets a reservation held as a shared pointer, for a change.
+ */
+static Reservation& kindOf(SharedReservation &shared) {
+	return *shared;
+}
+
+/**
+ * @brief Moves a reservation inline if it is of one of the kinds.
+ * @return False if it is of none of them.
+ */
+template<typename Kind, typename ... Others>
+static bool moveValue(Reservation &reservation, ReservationValue &value) {
+	if (Kind *kind = dynamic_cast<Kind*>(&reservation)) {
+		value.emplace<Kind>(std::move(*kind));
+		return true;
+	}
+	if constexpr (sizeof...(Others) > 0)
+		return moveValue<Others...>(reservation, value);
+	else
+		return false;
+}
+
+ReservationValue toValue(Reservation_ptr &&reservation) {
+	ReservationValue value;
+	if (!moveValue<CanadaFlightReservation, TurkishFlightReservation,
+			HiltonHotelReservation, MarriottHotelReservation>(*reservation, value))
+		value = SharedReservation(std::move(reservation));
+	return value;
+}
+
+Money getCost(const ReservationValue &reservation) {
+	//the kinds are final, so each call is a direct one.
+	return std::visit([](const auto &kind) {
+		return kindOf(kind).getCost();
+	}, reservation);
+}
+
+void getDetails(const ReservationValue &reservation, std::ostream &&get) {
+	std::visit([&get](const auto &kind) {
+		kindOf(kind).getDetails(std::move(get));
+	}, reservation);
+}
+
+void appendBookings(ReservationValue &reservation,
+		std::vector<Reservation*> &bookings) {
+	std::visit([&bookings](auto &kind) {
+		kindOf(kind).appendBookings(bookings);
+	}, reservation);
+}
@@ -0,0 +1,220 @@
+/**
+ * @file Result_Columns.cpp
+ * @brief Implements the columnar result containers and selection kernels
+ * @details Provides:
+ *          - Row append and rebuild for flight and room columns
+ *          - Branch-free range filters over contiguous columns
+ *          - Selection counting, listing and min/max
+ *          - Flight and room filters built from a search request
+ *
+ * @author Abdallah Salem
+ */
+#include "../include/Result_Columns.hpp"
+#include <limits>
+#include <algorithm>
+
+void FlightColumns::append(ProviderId airline, const Money &price,
+		DateTime departure, DateTime arrival) {
+	this->price.push_back(price.minorUnits());
+	this->currency.push_back(price.currency());
+	this->departure.push_back(departure.minuteNumber());
+	this->arrival.push_back(arrival.minuteNumber());
+	this->airline.push_back(airline);
+}
+
+void FlightColumns::append(const FoundFlightInfo &flight) {
+	append(flight.airline, flight.price, flight.from_date, flight.to_date);
+}
+
+void FlightColumns::reserve(std::size_t rows) {
+	price.reserve(rows);
+	currency.reserve(rows);
+	departure.reserve(rows);
+	arrival.reserve(rows);
+	airline.reserve(rows);
+}
+
+std::size_t FlightColumns::size() const {
+	return price.size();
+}
+
+FoundFlightInfo FlightColumns::row(std::size_t index) const {
+	return {airline[index], Money(price[index], currency[index]), DateTime(
+			departure[index]), DateTime(
+			arrival[index])};
+}
+
+void RoomColumns::append(ProviderId hotel, Date check_in, Date check_out,
+		const std::string &view_type, int available, const Money &price_per_night) {
+	this->price_per_night.push_back(price_per_night.minorUnits());
+	this->currency.push_back(price_per_night.currency());
+	this->check_in.push_back(check_in.dayNumber());
+	this->check_out.push_back(check_out.dayNumber());
+	this->available.push_back(available);
+	this->hotel.push_back(hotel);
+	this->view_type.push_back(view_type);
+}
+
+void RoomColumns::append(const FoundRoomInfo &room) {
+	append(room.hotel, room.from_date, room.to_date, room.view_type,
+			room.how_many, room.price_for_night);
+}
+
+void RoomColumns::reserve(std::size_t rows) {
+	price_per_night.reserve(rows);
+	currency.reserve(rows);
+	check_in.reserve(rows);
+	check_out.reserve(rows);
+	available.reserve(rows);
+	hotel.reserve(rows);
+	view_type.reserve(rows);
+}
+
+std::size_t RoomColumns::size() const {
+	return price_per_night.size();
+}
+
+std::vector<FoundFlightInfo> FlightColumns::rows(const Selection &selection) const {
+	std::vector<FoundFlightInfo> flights;
+	flights.reserve(countSelected(selection));
+	for (std::uint32_t index : selectedRows(selection))
+		flights.push_back(row(index));
+	return flights;
+}
+
+FoundRoomInfo RoomColumns::row(std::size_t index) const {
+	return {hotel[index], Date(check_in[index]), Date(check_out[index]),
+		view_type[index], available[index], Money(price_per_night[index],
+				currency[index])};
+}
+
+std::vector<FoundRoomInfo> RoomColumns::rows(const Selection &selection) const {
+	std::vector<FoundRoomInfo> rooms;
+	rooms.reserve(countSelected(selection));
+	for (std::uint32_t index : selectedRows(selection))
+		rooms.push_back(row(index));
+	return rooms;
+}
+
+Selection selectAll(std::size_t rows) {
+	return Selection(rows, 1);
+}
+
+/**
+ * @brief Shared body of the range filters.
+ * @details Comparisons are combined with '&' rather than '&&' so the loop has no
+ *          branch and compiles to packed compares.
+ */
+template<typename T>
+static void keepBetween(const std::vector<T> &column, T low, T high,
+		Selection &selection) {
+	const std::size_t rows = std::min(column.size(), selection.size());
+	const T *values = column.data();
+	std::uint8_t *keep = selection.data();
+	for (std::size_t i = 0; i < rows; i++)
+		keep[i] &= (std::uint8_t) ((values[i] >= low) & (values[i] <= high));
+}
+
+void keepInRange(const std::vector<std::int64_t> &column, std::int64_t low,
+		std::int64_t high, Selection &selection) {
+	keepBetween(column, low, high, selection);
+}
+
+void keepInRange(const std::vector<std::int32_t> &column, std::int32_t low,
+		std::int32_t high, Selection &selection) {
+	keepBetween(column, low, high, selection);
+}
+
+void keepAtLeast(const std::vector<std::int32_t> &column, std::int32_t minimum,
+		Selection &selection) {
+	keepBetween(column, minimum, std::numeric_limits<std::int32_t>::max(),
+			selection);
+}
+
+std::size_t countSelected(const Selection &selection) {
+	std::size_t count { };
+	for (std::uint8_t keep : selection)
+		count += keep;
+	return count;
+}
+
+std::vector<std::uint32_t> selectedRows(const Selection &selection) {
+	std::vector<std::uint32_t> rows;
+	rows.reserve(countSelected(selection));
+	for (std::size_t i = 0; i < selection.size(); i++)
+		if (selection[i])
+			rows.push_back((std::uint32_t) i);
+	return rows;
+}
+
+bool minMax(const std::vector<std::int64_t> &column, const Selection &selection,
+		std::int64_t &low, std::int64_t &high) {
+	const std::size_t rows = std::min(column.size(), selection.size());
+	const std::int64_t *values = column.data();
+	const std::uint8_t *keep = selection.data();
+	//unselected rows are replaced by neutral values instead of being skipped.
+	std::int64_t smallest = std::numeric_limits<std::int64_t>::max();
+	std::int64_t largest = std::numeric_limits<std::int64_t>::min();
+	std::size_t taken { };
+	for (std::size_t i = 0; i < rows; i++) {
+		std::int64_t as_low = keep[i] ? values[i] : smallest;
+		std::int64_t as_high = keep[i] ? values[i] : largest;
+		smallest = as_low < smallest ? as_low : smallest;
+		largest = as_high > largest ? as_high : largest;
+		taken += keep[i];
+	}
+	if (taken == 0)
+		return false;
+	low = smallest;
+	high = largest;
+	return true;
+}
+
+FlightFilter FlightFilter::forQuery(const PassengerInfo &query,
+		const Money &lowest, const Money &highest) {
+	FlightFilter filter;
+	filter.lowest_price = lowest.minorUnits();
+	if (!highest.isZero())
+		filter.highest_price = highest.minorUnits();
+	//any departure from the first day to the end of the last one.
+	if (DateTime(query.from_date).isValid())
+		filter.earliest_departure = DateTime(query.from_date).minuteNumber();
+	if (DateTime(query.to_date).isValid())
+		filter.latest_departure = DateTime(query.to_date).minuteNumber()
+				+ DateTime::MINUTES_PER_DAY - 1;
+	return filter;
+}
+
+Selection FlightFilter::select(const FlightColumns &columns) const {
+	Selection selection = selectAll(columns.size());
+	keepInRange(columns.price, lowest_price, highest_price, selection);
+	keepInRange(columns.departure, earliest_departure, latest_departure,
+			selection);
+	return selection;
+}
+
+RoomFilter RoomFilter::forQuery(const CustomerInfo &query, const Money &lowest,
+		const Money &highest) {
+	RoomFilter filter;
+	filter.lowest_price = lowest.minorUnits();
+	if (!highest.isZero())
+		filter.highest_price = highest.minorUnits();
+	//the room has to be free for the whole stay.
+	if (query.from_date.isValid())
+		filter.latest_check_in = query.from_date.dayNumber();
+	if (query.to_date.isValid())
+		filter.earliest_check_out = query.to_date.dayNumber();
+	filter.needed_rooms = std::max(1, query.needed_rooms);
+	return filter;
+}
+
+Selection RoomFilter::select(const RoomColumns &columns) const {
+	Selection selection = selectAll(columns.size());
+	keepInRange(columns.price_per_night, lowest_price, highest_price, selection);
+	keepInRange(columns.check_in, std::numeric_limits<std::int32_t>::min(),
+			latest_check_in, selection);
+	keepInRange(columns.check_out, earliest_check_out,
+			std::numeric_limits<std::int32_t>::max(), selection);
+	keepAtLeast(columns.available, needed_rooms, selection);
+	return selection;
+}
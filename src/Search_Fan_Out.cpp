@@ -0,0 +1,53 @@
+/**
+ * @file Search_Fan_Out.cpp
+ * @brief Implements the worker pool behind concurrent provider searches
+ * @details Provides:
+ *          - Worker thread start-up and shutdown
+ *          - Task queueing and execution
+ *
+ * @author Abdallah Salem
+ */
+#include "../include/Search_Fan_Out.hpp"
+
+WorkerPool::WorkerPool(std::size_t threads) {
+	if (threads == 0)
+		threads = 1;
+	for (std::size_t i = 0; i < threads; i++)
+		workers.emplace_back(&WorkerPool::work, this);
+}
+
+void WorkerPool::work() {
+	while (true) {
+		std::function<void()> task;
+		{
+			std::unique_lock<std::mutex> guard(lock);
+			wake.wait(guard, [this] {
+				return stopping || !tasks.empty();
+			});
+			//finish what is queued before leaving.
+			if (tasks.empty())
+				return;
+			task = std::move(tasks.front());
+			tasks.pop();
+		}
+		task();
+	}
+}
+
+void WorkerPool::submit(std::function<void()> task) {
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		tasks.push(std::move(task));
+	}
+	wake.notify_one();
+}
+
+WorkerPool::~WorkerPool() {
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		stopping = true;
+	}
+	wake.notify_all();
+	for (auto &worker : workers)
+		worker.join();
+}
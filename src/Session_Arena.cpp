@@ -0,0 +1,21 @@
+/**
+ * @file Session_Arena.cpp
+ * @brief Implements the per-session arena
+ *
+ * @author Abdallah Salem
+ */
+#include "../include/Session_Arena.hpp"
+
+SessionArena::SessionArena() :
+		arena(initial_block.data(), initial_block.size(),
+				std::pmr::new_delete_resource()) {
+}
+
+std::pmr::memory_resource* SessionArena::resource() {
+	return &arena;
+}
+
+void SessionArena::release() {
+	//back to the inline block; heap blocks are freed.
+	arena.release();
+}
@@ -3,36 +3,29 @@
  * @brief Implements user entity functionality
  * @details Provides methods for:
  *          - User profile management
- *          - Itinerary storage and viewing
+ *          - Itinerary storage and viewing, shared between copies of a user
  *          - User information handling
+ *          - Running total of the saved itineraries
  *
  * @author Abdallah Salem
  */
 #include "../include/user.hpp"
 
-Itinerary_ptr User::dynamicCast(Reservation_ptr &&reservation) {
-	if (Itinerary *it = dynamic_cast<Itinerary*>(reservation.get())) {
-		reservation.release();
-		return std::make_unique < Itinerary > (*it);
-	} else
-		return nullptr;
-}
-
 User::User(std::string username, std::string password, std::string email) :
 		username(username), password(password), email(email) {
 
 }
 
 User::User(const User &other) :
-		username(other.username), password(other.password), email(other.email) {
-	for (const auto &it : other.Itineraries)
-		User::addItinerary(it);
+		username(other.username), password(other.password), email(other.email), Itineraries(
+				other.Itineraries), total_cost(other.total_cost) {
 }
 
 User::User(User &&other) :
 		username(std::move(other.username)), password(
 				std::move(other.password)), email(std::move(other.email)), Itineraries(
-				std::move(other.Itineraries)) {
+				std::move(other.Itineraries)), total_cost(other.total_cost) {
+	other.total_cost = Money();
 
 }
 
@@ -41,8 +34,9 @@ User& User::operator=(const User &other) {
 		username = other.username;
 		password = other.password;
 		email = other.email;
-		for (const auto &it : other.Itineraries)
-			User::addItinerary(it);
+		Itineraries.insert(Itineraries.end(), other.Itineraries.begin(),
+				other.Itineraries.end());
+		total_cost += other.total_cost;
 	}
 	return *this;
 }
@@ -53,6 +47,8 @@ User& User::operator=(User &&other) {
 		password = std::move(other.password);
 		email = std::move(other.email);
 		Itineraries = std::move(other.Itineraries);
+		total_cost = other.total_cost;
+		other.total_cost = Money();
 	}
 	return *this;
 }
@@ -74,20 +70,23 @@ void User::viewMyProfile() const {
 	std::cout << "\nEmail: " << email << "\n\n";
 }
 void User::viewMyItineraries() const {
-	double total { };
-	for (const auto &it : Itineraries) {
+	for (const auto &it : Itineraries)
 		std::cout << (*it);
-		total += it->getCost();
-	}
-	std::cout << "\nTotal Cost for All Itineraries: " << total << "\n\n";
+	std::cout << "\nTotal Cost for All Itineraries: " << total_cost << "\n\n";
 }
 void User::addItinerary(const Itinerary_ptr &it) {
-	Itineraries.push_back(User::dynamicCast(std::move(it->clone())));
+	Itineraries.push_back(std::make_shared<const Itinerary>(*it));
+	total_cost += it->getCost();
 }
-void User::removeItinerary(Itinerary_ptr &it) {
+void User::removeItinerary(SharedItinerary &it) {
+	auto found = std::find(Itineraries.begin(), Itineraries.end(), it);
+	if (found == Itineraries.end())
+		return;
+	total_cost -= (*found)->getCost();
+	//it may be the element itself, so reset it before erasing.
 	it.reset();
-	Itineraries.erase(
-			std::remove(Itineraries.begin(), Itineraries.end(), nullptr),
-			Itineraries.end());
+	Itineraries.erase(found);
+}
+Money User::getTotalCost() const {
+	return total_cost;
 }
-
@@ -83,7 +83,7 @@ void UserManager::addItineraryToUser(const Itinerary_ptr &it) {
 		return;
 	logged_user->addItinerary(it);
 }
-void UserManager::removeItineraryFromUser(Itinerary_ptr &it) {
+void UserManager::removeItineraryFromUser(SharedItinerary &it) {
 	if (!logged_user)
 		return;
 	logged_user->removeItinerary(it);
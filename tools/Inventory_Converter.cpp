@@ -0,0 +1,207 @@
+/**
+ * @file Inventory_Converter.cpp
+ * @brief Converts provider inventory to the binary mapped format
+ * @details Usage: InventoryConverter flights|rooms <input.csv|input.jsonl> <output.inv>
+ *
+ *          CSV input has the columns the adapters read from their .csv files. JSONL input
+ *          has one object per line with the keys "from", "to", "price", "departure",
+ *          "arrival" for flights and "country", "city", "room_type", "available", "price",
+ *          "from", "to" for rooms, dates as strings. Malformed lines are reported and skipped.
+ *
+ * @author Abdallah Salem
+ */
+
+#include "../include/Mapped_Inventory.hpp"
+#include "../include/Date.hpp"
+#include "../include/Json.hpp"
+#include <fstream>
+#include <iostream>
+
+/**
+ * @brief Adds a flight offer from its text fields.
+ * @return False if a field is malformed.
+ */
+static bool addFlight(InventoryFileWriter &writer, const std::string &from,
+		const std::string &to, const Money &price, const std::string &departure,
+		const std::string &arrival) {
+	DateTime departure_time = DateTime::parse(departure);
+	DateTime arrival_time = DateTime::parse(arrival);
+	if (!departure_time.isValid() || !arrival_time.isValid())
+		return false;
+	writer.add(from, to, "", 0, departure_time.minuteNumber(),
+			arrival_time.minuteNumber(), price);
+	return true;
+}
+
+/**
+ * @brief Adds a room offer from its text fields.
+ * @return False if a field is malformed.
+ */
+static bool addRoom(InventoryFileWriter &writer, const std::string &country,
+		const std::string &city, const std::string &room_type, int available,
+		const Money &price, const std::string &from, const std::string &to) {
+	Date from_date = Date::parse(from);
+	Date to_date = Date::parse(to);
+	if (!from_date.isValid() || !to_date.isValid())
+		return false;
+	writer.add(country, city, room_type, available, from_date.dayNumber(),
+			to_date.dayNumber(), price);
+	return true;
+}
+
+/**
+ * @brief Reads the text of a number member straight from a JSONL line.
+ * @return False if the key is missing or its value is not a plain number.
+ */
+static bool jsonNumberText(const std::string &line, const std::string &key,
+		std::string &text) {
+	const std::string quoted = "\"" + key + "\"";
+	for (std::size_t at = line.find(quoted); at != std::string::npos;
+			at = line.find(quoted, at + 1)) {
+		//only a key is followed by a colon.
+		std::size_t colon = line.find_first_not_of(" \t", at + quoted.size());
+		if (colon == std::string::npos || line[colon] != ':')
+			continue;
+		std::size_t first = line.find_first_not_of(" \t", colon + 1);
+		if (first == std::string::npos)
+			return false;
+		std::size_t last = line.find_first_not_of("+-0123456789.eE", first);
+		text = line.substr(first,
+				last == std::string::npos ? std::string::npos : last - first);
+		return !text.empty();
+	}
+	return false;
+}
+
+/**
+ * @brief Reads the price of a JSONL line, with or without a fraction.
+ * @details The parser only keeps doubles, so the price is parsed exactly from its text,
+ *          like the CSV prices.
+ * @return False if the price is missing or not an amount with at most two decimals.
+ */
+static bool jsonPrice(const std::string &line, Money &price) {
+	std::string text;
+	return jsonNumberText(line, "price", text) && Money::parse(text, price);
+}
+
+/**
+ * @brief Reads a number that may be written with or without a fraction.
+ * @return False if the value is not a number.
+ */
+static bool jsonNumber(const json::JSON &value, double &number) {
+	bool ok = false;
+	if (value.JSONType() == json::JSON::Class::Integral)
+		number = (double) value.ToInt(ok);
+	else
+		number = value.ToFloat(ok);
+	return ok;
+}
+
+/**
+ * @brief Reads a string member of a JSONL object.
+ * @return False if the key is missing or not a string.
+ */
+static bool jsonText(const json::JSON &object, const std::string &key,
+		std::string &text) {
+	if (!object.hasKey(key))
+		return false;
+	bool ok = false;
+	text = object.at(key).ToString(ok);
+	return ok;
+}
+
+/**
+ * @brief Adds an offer from one JSONL line.
+ * @return False if the line is malformed.
+ */
+static bool addJsonLine(InventoryFileWriter &writer, bool flights,
+		const std::string &line) {
+	json::JSON object = json::JSON::Load(line);
+	if (object.JSONType() != json::JSON::Class::Object)
+		return false;
+	std::string first, second, from, to, room_type;
+	Money price;
+	double available { };
+	if (!object.hasKey("price") || !jsonPrice(line, price))
+		return false;
+	if (flights)
+		return jsonText(object, "from", first) && jsonText(object, "to", second)
+				&& jsonText(object, "departure", from)
+				&& jsonText(object, "arrival", to)
+				&& addFlight(writer, first, second, price, from, to);
+	return jsonText(object, "country", first) && jsonText(object, "city", second)
+			&& jsonText(object, "room_type", room_type)
+			&& object.hasKey("available")
+			&& jsonNumber(object.at("available"), available)
+			&& jsonText(object, "from", from) && jsonText(object, "to", to)
+			&& addRoom(writer, first, second, room_type, (int) available, price,
+					from, to);
+}
+
+/**
+ * @brief Reads a JSONL inventory file.
+ * @return False if the file could not be opened.
+ */
+static bool readJsonLines(const std::string &path, InventoryFileWriter &writer,
+		bool flights) {
+	std::ifstream file(path);
+	if (!file)
+		return false;
+	std::string line;
+	int line_number = 0;
+	while (std::getline(file, line)) {
+		line_number++;
+		if (line.find_first_not_of(" \t\r") == std::string::npos)
+			continue;
+		if (!addJsonLine(writer, flights, line))
+			std::cerr << path << ":" << line_number
+					<< ": malformed inventory line skipped\n";
+	}
+	return true;
+}
+
+/**
+ * @brief Reads a CSV inventory file.
+ * @return False if the file could not be opened.
+ */
+static bool readCsv(const std::string &path, InventoryFileWriter &writer,
+		bool flights) {
+	return readInventoryFile(path, [&](const std::vector<std::string> &fields) {
+		Money price;
+		int available { };
+		if (flights)
+			return fields.size() == 5 && parseInventoryNumber(fields[2], price)
+					&& addFlight(writer, fields[0], fields[1], price, fields[3],
+							fields[4]);
+		return fields.size() == 7 && parseInventoryNumber(fields[3], available)
+				&& parseInventoryNumber(fields[4], price)
+				&& addRoom(writer, fields[0], fields[1], fields[2], available,
+						price, fields[5], fields[6]);
+	});
+}
+
+int main(int argc, char *argv[]) {
+	std::string kind = argc == 4 ? argv[1] : "";
+	if (kind != "flights" && kind != "rooms") {
+		std::cerr << "usage: InventoryConverter flights|rooms "
+				"<input.csv|input.jsonl> <output.inv>\n";
+		return 2;
+	}
+	std::string input = argv[2], output = argv[3];
+	bool flights = kind == "flights";
+	bool jsonl = input.size() >= 6 && input.substr(input.size() - 6) == ".jsonl";
+	InventoryFileWriter writer;
+	bool opened =
+			jsonl ? readJsonLines(input, writer, flights) :
+					readCsv(input, writer, flights);
+	if (!opened) {
+		std::cerr << input << ": cannot open\n";
+		return 1;
+	}
+	if (!writer.write(output)) {
+		std::cerr << output << ": cannot write\n";
+		return 1;
+	}
+	std::cout << output << ": " << writer.size() << " offers\n";
+	return 0;
+}